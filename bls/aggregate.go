@@ -0,0 +1,236 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"sync"
+	"time"
+	"unsafe"
+)
+
+// parallelAggregationThreshold is the number of points above which aggregation is split across
+// the worker pool. Smaller inputs are summed in a single call.
+const parallelAggregationThreshold = 1024
+
+// aggregatePublicKeysPtrs sums the public keys as a two level tree: each worker of the pool aggregates a
+// contiguous chunk, and the partial aggregates are then summed.
+func aggregatePublicKeysPtrs(publicKeysPtrs []*C.struct_PublicKey) (*PublicKey, error) {
+	if len(publicKeysPtrs) < parallelAggregationThreshold {
+		aggregatedPublicKey := &PublicKey{}
+		defer aggregateMetrics.Record(time.Now())
+		success := C.aggregate_public_keys((**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])), C.int(len(publicKeysPtrs)), &aggregatedPublicKey.ptr)
+		if !success {
+			return nil, GeneralError
+		}
+
+		return aggregatedPublicKey, nil
+	}
+
+	var partialsMutex sync.Mutex
+	partials := []*C.struct_PublicKey{}
+	failed := false
+	parallelChunksWith(len(publicKeysPtrs), parallelAggregationThreshold/2, 0, func(start, end int) {
+		var partial *C.struct_PublicKey
+		defer aggregateMetrics.Record(time.Now())
+		success := C.aggregate_public_keys((**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[start])), C.int(end-start), &partial)
+
+		partialsMutex.Lock()
+		defer partialsMutex.Unlock()
+		if !success {
+			failed = true
+			return
+		}
+		partials = append(partials, partial)
+	})
+	defer func() {
+		for _, partial := range partials {
+			C.destroy_public_key(partial)
+		}
+	}()
+	if failed {
+		return nil, GeneralError
+	}
+
+	aggregatedPublicKey := &PublicKey{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.aggregate_public_keys((**C.struct_PublicKey)(unsafe.Pointer(&partials[0])), C.int(len(partials)), &aggregatedPublicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return aggregatedPublicKey, nil
+}
+
+// aggregateSignaturesPtrs sums the signatures as a two level tree, like aggregatePublicKeysPtrs.
+func aggregateSignaturesPtrs(signaturesPtrs []*C.struct_Signature) (*Signature, error) {
+	if len(signaturesPtrs) < parallelAggregationThreshold {
+		aggregatedSignature := &Signature{}
+		defer aggregateMetrics.Record(time.Now())
+		success := C.aggregate_signatures((**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[0])), C.int(len(signaturesPtrs)), &aggregatedSignature.ptr)
+		if !success {
+			return nil, GeneralError
+		}
+
+		return aggregatedSignature, nil
+	}
+
+	var partialsMutex sync.Mutex
+	partials := []*C.struct_Signature{}
+	failed := false
+	parallelChunksWith(len(signaturesPtrs), parallelAggregationThreshold/2, 0, func(start, end int) {
+		var partial *C.struct_Signature
+		defer aggregateMetrics.Record(time.Now())
+		success := C.aggregate_signatures((**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[start])), C.int(end-start), &partial)
+
+		partialsMutex.Lock()
+		defer partialsMutex.Unlock()
+		if !success {
+			failed = true
+			return
+		}
+		partials = append(partials, partial)
+	})
+	defer func() {
+		for _, partial := range partials {
+			C.destroy_signature(partial)
+		}
+	}()
+	if failed {
+		return nil, GeneralError
+	}
+
+	aggregatedSignature := &Signature{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.aggregate_signatures((**C.struct_Signature)(unsafe.Pointer(&partials[0])), C.int(len(partials)), &aggregatedSignature.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return aggregatedSignature, nil
+}
+
+// AggregatePublicKeysMany aggregates each group of public keys independently, such as the signers of many committees.
+// The groups are spread across the worker pool, and each worker aggregates its share of the groups in one call.
+func AggregatePublicKeysMany(groups [][]*PublicKey) ([]*PublicKey, error) {
+	if len(groups) == 0 {
+		return nil, EmptySliceError
+	}
+
+	offsets := make([]int, len(groups)+1)
+	groupLens := make([]C.int, len(groups))
+	for i, group := range groups {
+		if len(group) == 0 {
+			return nil, EmptySliceError
+		}
+		groupLens[i] = C.int(len(group))
+		offsets[i+1] = offsets[i] + len(group)
+	}
+	publicKeysPtrs := make([]*C.struct_PublicKey, 0, offsets[len(groups)])
+	for _, group := range groups {
+		for _, pk := range group {
+			if pk == nil {
+				return nil, NilPointerError
+			}
+			publicKeysPtrs = append(publicKeysPtrs, pk.ptr)
+		}
+	}
+
+	aggregatedPtrs := make([]*C.struct_PublicKey, len(groups))
+	cResults := make([]C.bool, len(groups))
+	parallelChunksWith(len(groups), 1, 0, func(start, end int) {
+		defer aggregateMetrics.Record(time.Now())
+		cResults[start] = C.aggregate_public_keys_many(
+			(**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[offsets[start]])),
+			&groupLens[start],
+			C.int(end-start),
+			&aggregatedPtrs[start],
+		)
+		for i := start + 1; i < end; i++ {
+			cResults[i] = cResults[start]
+		}
+	})
+
+	aggregated := make([]*PublicKey, len(groups))
+	var err error
+	for i, ptr := range aggregatedPtrs {
+		if !cResults[i] {
+			err = GeneralError
+			continue
+		}
+		aggregated[i] = &PublicKey{ptr: ptr}
+	}
+	if err != nil {
+		for _, pk := range aggregated {
+			if pk != nil {
+				pk.Destroy()
+			}
+		}
+		return nil, err
+	}
+
+	return aggregated, nil
+}
+
+// AggregateSignaturesMany aggregates each group of signatures independently, like AggregatePublicKeysMany.
+func AggregateSignaturesMany(groups [][]*Signature) ([]*Signature, error) {
+	if len(groups) == 0 {
+		return nil, EmptySliceError
+	}
+
+	offsets := make([]int, len(groups)+1)
+	groupLens := make([]C.int, len(groups))
+	for i, group := range groups {
+		if len(group) == 0 {
+			return nil, EmptySliceError
+		}
+		groupLens[i] = C.int(len(group))
+		offsets[i+1] = offsets[i] + len(group)
+	}
+	signaturesPtrs := make([]*C.struct_Signature, 0, offsets[len(groups)])
+	for _, group := range groups {
+		for _, sig := range group {
+			if sig == nil {
+				return nil, NilPointerError
+			}
+			signaturesPtrs = append(signaturesPtrs, sig.ptr)
+		}
+	}
+
+	aggregatedPtrs := make([]*C.struct_Signature, len(groups))
+	cResults := make([]C.bool, len(groups))
+	parallelChunksWith(len(groups), 1, 0, func(start, end int) {
+		defer aggregateMetrics.Record(time.Now())
+		cResults[start] = C.aggregate_signatures_many(
+			(**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[offsets[start]])),
+			&groupLens[start],
+			C.int(end-start),
+			&aggregatedPtrs[start],
+		)
+		for i := start + 1; i < end; i++ {
+			cResults[i] = cResults[start]
+		}
+	})
+
+	aggregated := make([]*Signature, len(groups))
+	var err error
+	for i, ptr := range aggregatedPtrs {
+		if !cResults[i] {
+			err = GeneralError
+			continue
+		}
+		aggregated[i] = &Signature{ptr: ptr}
+	}
+	if err != nil {
+		for _, sig := range aggregated {
+			if sig != nil {
+				sig.Destroy()
+			}
+		}
+		return nil, err
+	}
+
+	return aggregated, nil
+}
@@ -0,0 +1,98 @@
+#include "bls_ext.h"
+
+struct Arena {
+  PublicKey **public_keys;
+  int public_keys_len;
+  int public_keys_cap;
+  Signature **signatures;
+  int signatures_len;
+  int signatures_cap;
+};
+
+/* Grows a handle array geometrically so that it can hold one more handle. */
+static bool arena_reserve(void ***handles, int len, int *cap) {
+  if (len < *cap) {
+    return true;
+  }
+  int new_cap = *cap > 0 ? 2 * *cap : 64;
+  void **grown = realloc(*handles, (size_t)new_cap * sizeof(void *));
+  if (grown == NULL) {
+    return false;
+  }
+  *handles = grown;
+  *cap = new_cap;
+  return true;
+}
+
+static bool arena_adopt_public_key(Arena *arena, PublicKey *public_key) {
+  if (!arena_reserve((void ***)&arena->public_keys, arena->public_keys_len, &arena->public_keys_cap)) {
+    destroy_public_key(public_key);
+    return false;
+  }
+  arena->public_keys[arena->public_keys_len++] = public_key;
+  return true;
+}
+
+static bool arena_adopt_signature(Arena *arena, Signature *signature) {
+  if (!arena_reserve((void ***)&arena->signatures, arena->signatures_len, &arena->signatures_cap)) {
+    destroy_signature(signature);
+    return false;
+  }
+  arena->signatures[arena->signatures_len++] = signature;
+  return true;
+}
+
+bool bls_arena_create(Arena **out_arena) {
+  Arena *arena = calloc(1, sizeof(Arena));
+  if (arena == NULL) {
+    return false;
+  }
+  *out_arena = arena;
+  return true;
+}
+
+bool bls_arena_deserialize_public_key(Arena *arena,
+                                      const uint8_t *in_public_key_bytes,
+                                      int in_public_key_bytes_len,
+                                      PublicKey **out_public_key) {
+  return deserialize_public_key(in_public_key_bytes, in_public_key_bytes_len, out_public_key) &&
+         arena_adopt_public_key(arena, *out_public_key);
+}
+
+bool bls_arena_deserialize_signature(Arena *arena,
+                                     const uint8_t *in_signature_bytes,
+                                     int in_signature_bytes_len,
+                                     Signature **out_signature) {
+  return deserialize_signature(in_signature_bytes, in_signature_bytes_len, out_signature) &&
+         arena_adopt_signature(arena, *out_signature);
+}
+
+bool bls_arena_aggregate_public_keys(Arena *arena,
+                                     const PublicKey *const *in_public_keys,
+                                     int in_public_keys_len,
+                                     PublicKey **out_public_key) {
+  return aggregate_public_keys(in_public_keys, in_public_keys_len, out_public_key) &&
+         arena_adopt_public_key(arena, *out_public_key);
+}
+
+bool bls_arena_aggregate_signatures(Arena *arena,
+                                    const Signature *const *in_signatures,
+                                    int in_signatures_len,
+                                    Signature **out_signature) {
+  return aggregate_signatures(in_signatures, in_signatures_len, out_signature) &&
+         arena_adopt_signature(arena, *out_signature);
+}
+
+bool bls_arena_destroy(Arena *arena) {
+  bool success = true;
+  for (int i = 0; i < arena->public_keys_len; i++) {
+    success = destroy_public_key(arena->public_keys[i]) && success;
+  }
+  for (int i = 0; i < arena->signatures_len; i++) {
+    success = destroy_signature(arena->signatures[i]) && success;
+  }
+  free(arena->public_keys);
+  free(arena->signatures);
+  free(arena);
+  return success;
+}
@@ -0,0 +1,148 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"errors"
+	"sync"
+	"time"
+	"unsafe"
+)
+
+// DestroyedError is returned by the methods of an Arena which was destroyed.
+var DestroyedError = errors.New("Arena was destroyed")
+
+// Arena owns the public keys and signatures created through it and releases all of them with a single Destroy call,
+// such as the handles used to verify one block. Handles created by an arena must not be destroyed individually,
+// and must not be used after the arena is destroyed. The methods of a destroyed arena return DestroyedError.
+type Arena struct {
+	mutex sync.Mutex
+	ptr   *C.struct_Arena
+}
+
+func NewArena() (*Arena, error) {
+	arena := &Arena{}
+	success := C.bls_arena_create(&arena.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return arena, nil
+}
+
+func (self *Arena) DeserializePublicKey(publicKeyBytes []byte) (*PublicKey, error) {
+	err := validatePublicKey(publicKeyBytes)
+	if err != nil {
+		return nil, err
+	}
+
+	publicKeyPtr, publicKeyLen := sliceToPtr(publicKeyBytes)
+
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+	if self.ptr == nil {
+		return nil, DestroyedError
+	}
+	publicKey := &PublicKey{}
+	defer deserializeMetrics.Record(time.Now())
+	success := C.bls_arena_deserialize_public_key(self.ptr, publicKeyPtr, publicKeyLen, &publicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return publicKey, nil
+}
+
+func (self *Arena) DeserializeSignature(signatureBytes []byte) (*Signature, error) {
+	err := validateSignature(signatureBytes)
+	if err != nil {
+		return nil, err
+	}
+
+	signaturePtr, signatureLen := sliceToPtr(signatureBytes)
+
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+	if self.ptr == nil {
+		return nil, DestroyedError
+	}
+	signature := &Signature{}
+	defer deserializeMetrics.Record(time.Now())
+	success := C.bls_arena_deserialize_signature(self.ptr, signaturePtr, signatureLen, &signature.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return signature, nil
+}
+
+func (self *Arena) AggregatePublicKeys(publicKeys []*PublicKey) (*PublicKey, error) {
+	if len(publicKeys) == 0 {
+		return nil, EmptySliceError
+	}
+
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(publicKeys))
+	for i, pk := range publicKeys {
+		if pk == nil {
+			return nil, NilPointerError
+		}
+		publicKeysPtrs[i] = pk.ptr
+	}
+
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+	if self.ptr == nil {
+		return nil, DestroyedError
+	}
+	aggregatedPublicKey := &PublicKey{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.bls_arena_aggregate_public_keys(self.ptr, (**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])), C.int(len(publicKeysPtrs)), &aggregatedPublicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return aggregatedPublicKey, nil
+}
+
+func (self *Arena) AggregateSignatures(signatures []*Signature) (*Signature, error) {
+	if len(signatures) == 0 {
+		return nil, EmptySliceError
+	}
+
+	signaturesPtrs := make([]*C.struct_Signature, len(signatures))
+	for i, sig := range signatures {
+		if sig == nil {
+			return nil, NilPointerError
+		}
+		signaturesPtrs[i] = sig.ptr
+	}
+
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+	if self.ptr == nil {
+		return nil, DestroyedError
+	}
+	aggregatedSignature := &Signature{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.bls_arena_aggregate_signatures(self.ptr, (**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[0])), C.int(len(signaturesPtrs)), &aggregatedSignature.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return aggregatedSignature, nil
+}
+
+// Destroy releases the arena and every handle created through it. It returns false if the arena was already destroyed.
+func (self *Arena) Destroy() bool {
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+	if self.ptr == nil {
+		return false
+	}
+	success := C.bls_arena_destroy(self.ptr)
+	self.ptr = nil
+	return bool(success)
+}
@@ -0,0 +1,190 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+)
+
+var ClosedError = errors.New("Verifier was closed")
+
+// VerifyJob is a signature verification submitted to an AsyncVerifier.
+type VerifyJob struct {
+	PublicKey *PublicKey
+	Message   []byte
+	Extra     []byte
+	Signature *Signature
+
+	ShouldUseCompositeHasher bool
+	ShouldUseCIP22           bool
+}
+
+type pendingJob struct {
+	job    VerifyJob
+	result chan error
+}
+
+// AsyncVerifier verifies submitted signatures on a fixed number of workers, so that thousands of concurrent
+// callers do not each block an OS thread in cgo. Each worker takes all the jobs pending when it becomes idle,
+// up to a maximum batch size, and verifies them together: jobs over the same message share one strict batch,
+// and all batches with the same hasher flags are verified in one `batch_verify_strict` call.
+type AsyncVerifier struct {
+	jobs         chan pendingJob
+	maxBatchSize int
+	workers      sync.WaitGroup
+
+	closeMutex sync.RWMutex
+	closed     bool
+}
+
+// NewAsyncVerifier starts an AsyncVerifier with the given number of workers, GOMAXPROCS if zero, each verifying
+// at most maxBatchSize jobs per call, 128 if zero.
+func NewAsyncVerifier(workers, maxBatchSize int) *AsyncVerifier {
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	if maxBatchSize <= 0 {
+		maxBatchSize = 128
+	}
+
+	self := &AsyncVerifier{
+		jobs:         make(chan pendingJob, maxBatchSize*workers),
+		maxBatchSize: maxBatchSize,
+	}
+	for i := 0; i < workers; i++ {
+		self.workers.Add(1)
+		go func() {
+			defer self.workers.Done()
+			self.run()
+		}()
+	}
+
+	return self
+}
+
+// Submit queues a verification and returns a channel which receives its result: nil if the signature verified,
+// NotVerifiedError if it did not, or another error.
+func (self *AsyncVerifier) Submit(job VerifyJob) <-chan error {
+	result := make(chan error, 1)
+	if job.PublicKey == nil || job.Signature == nil {
+		result <- NilPointerError
+		return result
+	}
+
+	self.closeMutex.RLock()
+	defer self.closeMutex.RUnlock()
+	if self.closed {
+		result <- ClosedError
+		return result
+	}
+
+	self.jobs <- pendingJob{job: job, result: result}
+	return result
+}
+
+// Close stops accepting jobs and waits for the submitted ones to be verified.
+func (self *AsyncVerifier) Close() {
+	self.closeMutex.Lock()
+	if !self.closed {
+		self.closed = true
+		close(self.jobs)
+	}
+	self.closeMutex.Unlock()
+
+	self.workers.Wait()
+}
+
+func (self *AsyncVerifier) run() {
+	pending := make([]pendingJob, 0, self.maxBatchSize)
+	for first := range self.jobs {
+		pending = append(pending[:0], first)
+	drain:
+		for len(pending) < self.maxBatchSize {
+			select {
+			case job, ok := <-self.jobs:
+				if !ok {
+					break drain
+				}
+				pending = append(pending, job)
+			default:
+				break drain
+			}
+		}
+
+		verifyPending(pending)
+	}
+}
+
+type jobFlags struct {
+	shouldUseCompositeHasher bool
+	shouldUseCIP22           bool
+}
+
+type jobMessage struct {
+	flags jobFlags
+	data  string
+	extra string
+}
+
+// verifyPending groups the jobs by message and verifies all messages with the same flags in one call.
+func verifyPending(pending []pendingJob) {
+	groups := make(map[jobFlags][]*jobMessage)
+	jobsByMessage := make(map[jobMessage][]pendingJob)
+	for _, job := range pending {
+		flags := jobFlags{job.job.ShouldUseCompositeHasher, job.job.ShouldUseCIP22}
+		key := jobMessage{flags: flags, data: string(job.job.Message), extra: string(job.job.Extra)}
+		if _, ok := jobsByMessage[key]; !ok {
+			groups[flags] = append(groups[flags], &key)
+		}
+		jobsByMessage[key] = append(jobsByMessage[key], job)
+	}
+
+	for flags, messages := range groups {
+		batches := make([]*Batch, len(messages))
+		sameMessages := make([]*sameMessage, len(messages))
+		for i, message := range messages {
+			jobs := jobsByMessage[*message]
+			sameMessages[i] = &sameMessage{
+				data:                     jobs[0].job.Message,
+				extra:                    jobs[0].job.Extra,
+				shouldUseCompositeHasher: flags.shouldUseCompositeHasher,
+				shouldUseCIP22:           flags.shouldUseCIP22,
+			}
+			publicKeys := make([]*PublicKey, len(jobs))
+			signatures := make([]*Signature, len(jobs))
+			for j, job := range jobs {
+				publicKeys[j] = job.job.PublicKey
+				signatures[j] = job.job.Signature
+			}
+			batches[i] = sameMessages[i].batch(publicKeys, signatures)
+		}
+
+		cResults := make([]C.bool, len(batches))
+		batchVerifyStrict(batches, flags.shouldUseCompositeHasher, flags.shouldUseCIP22, cResults)
+
+		for i, message := range messages {
+			jobs := jobsByMessage[*message]
+			results := make([]bool, len(jobs))
+			if cResults[i] {
+				for j := range results {
+					results[j] = true
+				}
+			} else {
+				sameMessages[i].bisect(batches[i].Pubkeys, batches[i].Sigs, results)
+			}
+
+			for j, job := range jobs {
+				if results[j] {
+					job.result <- nil
+				} else {
+					job.result <- NotVerifiedError
+				}
+			}
+		}
+	}
+}
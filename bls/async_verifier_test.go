@@ -0,0 +1,103 @@
+// +build windows
+
+package bls
+
+import (
+	"fmt"
+	"testing"
+)
+
+// sharedMessages returns messages of which the first half are the same, and the second half all differ.
+func sharedMessages(n int) [][]byte {
+	messages := make([][]byte, n)
+	for i := range messages {
+		if i < n/2 {
+			messages[i] = []byte("proposal")
+		} else {
+			messages[i] = []byte(fmt.Sprintf("message %d", i))
+		}
+	}
+	return messages
+}
+
+func TestAsyncVerifier(t *testing.T) {
+	signers := newSigners(t, 12)
+	defer destroySigners(signers)
+
+	// A bad vote over the shared message, then over a message of its own
+	for _, bad := range []map[int]bool{{}, {3: true}, {9: true}, {0: true, 11: true}} {
+		t.Run(fmt.Sprint(bad), func(t *testing.T) {
+			votes := newVotes(t, signers, sharedMessages(len(signers)), bad, true, true)
+			defer destroyVotes(votes)
+
+			verifier := NewAsyncVerifier(2, 4)
+			results := make([]<-chan error, len(votes))
+			for i, vote := range votes {
+				results[i] = verifier.Submit(VerifyJob{
+					PublicKey:                vote.publicKey,
+					Message:                  vote.message,
+					Signature:                vote.signature,
+					ShouldUseCompositeHasher: true,
+					ShouldUseCIP22:           true,
+				})
+			}
+			// Close returns once all submitted jobs are verified
+			verifier.Close()
+
+			for i, vote := range votes {
+				select {
+				case err := <-results[i]:
+					requireVoteResult(t, i, vote, err)
+				default:
+					t.Fatalf("vote %d: no result after Close", i)
+				}
+				select {
+				case err := <-results[i]:
+					t.Fatalf("vote %d: a second result was delivered: %v", i, err)
+				default:
+				}
+			}
+		})
+	}
+}
+
+func TestAsyncVerifierMixedHashers(t *testing.T) {
+	signers := newSigners(t, 6)
+	defer destroySigners(signers)
+	messages := sharedMessages(len(signers))
+	composite := newVotes(t, signers, messages, map[int]bool{1: true}, true, true)
+	defer destroyVotes(composite)
+	direct := newVotes(t, signers, messages, map[int]bool{4: true}, false, false)
+	defer destroyVotes(direct)
+
+	verifier := NewAsyncVerifier(1, 0)
+	defer verifier.Close()
+	compositeResults := make([]<-chan error, len(signers))
+	directResults := make([]<-chan error, len(signers))
+	for i := range signers {
+		compositeResults[i] = verifier.Submit(VerifyJob{PublicKey: composite[i].publicKey, Message: messages[i], Signature: composite[i].signature, ShouldUseCompositeHasher: true, ShouldUseCIP22: true})
+		directResults[i] = verifier.Submit(VerifyJob{PublicKey: direct[i].publicKey, Message: messages[i], Signature: direct[i].signature})
+	}
+	for i := range signers {
+		requireVoteResult(t, i, composite[i], receiveOnce(t, compositeResults[i]))
+		requireVoteResult(t, i, direct[i], receiveOnce(t, directResults[i]))
+	}
+}
+
+func TestAsyncVerifierClosed(t *testing.T) {
+	signers := newSigners(t, 1)
+	defer destroySigners(signers)
+	votes := newVotes(t, signers, [][]byte{[]byte("message")}, nil, true, true)
+	defer destroyVotes(votes)
+
+	verifier := NewAsyncVerifier(1, 1)
+	verifier.Close()
+	verifier.Close()
+	result := verifier.Submit(VerifyJob{PublicKey: votes[0].publicKey, Message: votes[0].message, Signature: votes[0].signature})
+	if err := receiveOnce(t, result); err != ClosedError {
+		t.Errorf("expected ClosedError, got %v", err)
+	}
+	if err := receiveOnce(t, verifier.Submit(VerifyJob{})); err != NilPointerError {
+		t.Errorf("expected NilPointerError, got %v", err)
+	}
+}
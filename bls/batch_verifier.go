@@ -0,0 +1,182 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"runtime"
+	"sync"
+	"time"
+	"unsafe"
+)
+
+// cBuffer is C allocated scratch memory for the FFI arrays passed to the library, which may hold Go pointers
+// and so cannot live in Go memory. It grows geometrically and is kept between calls.
+type cBuffer struct {
+	ptr  unsafe.Pointer
+	size int
+}
+
+// reserve makes the buffer at least size bytes long, discarding its contents if it has to grow.
+func (self *cBuffer) reserve(size int) unsafe.Pointer {
+	if size > self.size {
+		newSize := 2 * self.size
+		if newSize < size {
+			newSize = size
+		}
+		C.free(self.ptr)
+		self.ptr = C.malloc(C.size_t(newSize))
+		self.size = newSize
+	}
+	return self.ptr
+}
+
+func (self *cBuffer) free() {
+	C.free(self.ptr)
+	self.ptr = nil
+	self.size = 0
+}
+
+// batchBuffers holds the arrays passed to `batch_verify_strict`: the messages, and the public key and
+// signature pointers which all batches point into.
+type batchBuffers struct {
+	messages   cBuffer
+	publicKeys cBuffer
+	signatures cBuffer
+}
+
+func (self *batchBuffers) free() {
+	self.messages.free()
+	self.publicKeys.free()
+	self.signatures.free()
+}
+
+// batchBuffersPool recycles the buffers of the package level batch functions. The pool may drop its buffers
+// at any time, so they are freed by a finalizer.
+var batchBuffersPool = sync.Pool{
+	New: func() interface{} {
+		buffers := &batchBuffers{}
+		runtime.SetFinalizer(buffers, (*batchBuffers).free)
+		return buffers
+	},
+}
+
+// verify calls `batch_verify_strict` over the batches, writing the result of each batch to cResults.
+func (self *batchBuffers) verify(batches []*Batch, shouldUseCompositeHasher, shouldUseCIP22 bool, cResults []C.bool) bool {
+	batchCount := len(batches)
+	publicKeysCount, signaturesCount := 0, 0
+	for _, batch := range batches {
+		publicKeysCount += len(batch.Pubkeys)
+		signaturesCount += len(batch.Sigs)
+	}
+
+	size := int(unsafe.Sizeof(C.BatchMessageFFI{}))
+	pointerSize := int(unsafe.Sizeof(uintptr(0)))
+	messages_ptr := self.messages.reserve(size * batchCount)
+	publicKeys := (*[1 << 28]*C.struct_PublicKey)(self.publicKeys.reserve(pointerSize * publicKeysCount))
+	signatures := (*[1 << 28]*C.struct_Signature)(self.signatures.reserve(pointerSize * signaturesCount))
+
+	// Put our data in the format the library expects
+	publicKeysLen, signaturesLen := 0, 0
+	for i := 0; i < batchCount; i++ {
+		// convert the slices to pointers
+		data := toBuffer(batches[i].Data)
+		extra := toBuffer(batches[i].Extra)
+
+		publicKeysStart := publicKeysLen
+		for _, pk := range batches[i].Pubkeys {
+			if pk == nil {
+				continue
+			}
+			publicKeys[publicKeysLen] = pk.ptr
+			publicKeysLen++
+		}
+
+		signaturesStart := signaturesLen
+		for _, sig := range batches[i].Sigs {
+			if sig == nil {
+				continue
+			}
+			signatures[signaturesLen] = sig.ptr
+			signaturesLen++
+		}
+
+		// Get messages_ptr[i] (need to offset by i*size to take into account the size of C.MessageFFI)
+		msg := (*C.BatchMessageFFI)(unsafe.Pointer(uintptr(messages_ptr) + uintptr(size*i)))
+		// ...and write to it
+		*msg = C.BatchMessageFFI{
+			data:            data,
+			extra:           extra,
+			public_keys:     (**C.struct_PublicKey)(unsafe.Pointer(uintptr(unsafe.Pointer(publicKeys)) + uintptr(pointerSize*publicKeysStart))),
+			public_keys_len: C.int(publicKeysLen - publicKeysStart),
+			signatures:      (**C.struct_Signature)(unsafe.Pointer(uintptr(unsafe.Pointer(signatures)) + uintptr(pointerSize*signaturesStart))),
+			signatures_len:  C.int(signaturesLen - signaturesStart),
+		}
+	}
+
+	defer batchVerifyMetrics.Record(time.Now())
+	return bool(C.batch_verify_strict(
+		(*C.BatchMessageFFI)(messages_ptr),
+		C.int(batchCount),
+		C.bool(shouldUseCompositeHasher),
+		C.bool(shouldUseCIP22),
+		(*C.bool)(unsafe.Pointer(&cResults[0])),
+	))
+}
+
+// BatchVerifier is a reusable context for strict batch verification. It keeps the native arrays passed to the
+// library between calls, so that a verifier which is reset and refilled for every block does not allocate them again.
+// BatchVerifier is not safe for concurrent use.
+type BatchVerifier struct {
+	batches  []*Batch
+	buffers  batchBuffers
+	cResults []C.bool
+}
+
+func NewBatchVerifier() *BatchVerifier {
+	return &BatchVerifier{}
+}
+
+// Add appends a batch to be verified by the next Verify call. The batch must not be modified until then.
+func (self *BatchVerifier) Add(batch *Batch) {
+	self.batches = append(self.batches, batch)
+}
+
+// Len returns the number of batches added since the last Reset.
+func (self *BatchVerifier) Len() int {
+	return len(self.batches)
+}
+
+// Reset removes all batches, keeping the allocated buffers for reuse.
+func (self *BatchVerifier) Reset() {
+	for i := range self.batches {
+		self.batches[i] = nil
+	}
+	self.batches = self.batches[:0]
+}
+
+// Verify verifies the added batches, with the same results as BatchVerifyStrict.
+func (self *BatchVerifier) Verify(shouldUseCompositeHasher, shouldUseCIP22 bool) ([]bool, error) {
+	if len(self.batches) == 0 {
+		return nil, EmptySliceError
+	}
+	if cap(self.cResults) < len(self.batches) {
+		self.cResults = make([]C.bool, len(self.batches), 2*len(self.batches))
+	}
+	cResults := self.cResults[:len(self.batches)]
+
+	overallResult := self.buffers.verify(self.batches, shouldUseCompositeHasher, shouldUseCIP22, cResults)
+	if !overallResult {
+		return toBoolSlice(cResults), NotVerifiedError
+	}
+
+	return nil, nil
+}
+
+// Destroy releases the native buffers of the verifier.
+func (self *BatchVerifier) Destroy() {
+	self.Reset()
+	self.buffers.free()
+}
@@ -0,0 +1,85 @@
+// +build windows
+
+package bls
+
+import (
+	"fmt"
+	"testing"
+)
+
+// signedHeaders returns headers which are each signed over a different message, except for the bad ones whose
+// signature is over another message.
+func signedHeaders(t *testing.T, signers []signer, bad map[int]bool) []*SignedBlockHeader {
+	headers := make([]*SignedBlockHeader, len(signers))
+	for i, signer := range signers {
+		message := []byte(fmt.Sprintf("epoch %d", i))
+		signedMessage := message
+		if bad[i] {
+			signedMessage = []byte("another epoch")
+		}
+		headers[i] = &SignedBlockHeader{
+			Data:   message,
+			Extra:  []byte("extra"),
+			Pubkey: signer.publicKey,
+			Sig:    sign(t, signer.privateKey, signedMessage, []byte("extra"), true, true),
+		}
+	}
+	return headers
+}
+
+func destroyHeaders(headers []*SignedBlockHeader) {
+	for _, header := range headers {
+		header.Sig.Destroy()
+	}
+}
+
+func TestBatchVerifyEpochsDetailed(t *testing.T) {
+	signers := newSigners(t, 11)
+	defer destroySigners(signers)
+
+	for _, bad := range []map[int]bool{{}, {7: true}, {0: true}, {10: true}, {2: true, 8: true}, {4: true, 5: true}} {
+		t.Run(fmt.Sprint(bad), func(t *testing.T) {
+			headers := signedHeaders(t, signers, bad)
+			defer destroyHeaders(headers)
+
+			results, err := BatchVerifyEpochsDetailed(headers, true, true)
+			if len(bad) == 0 {
+				if err != nil || results != nil {
+					t.Fatalf("expected all headers to verify, got %v %v", results, err)
+				}
+				return
+			}
+			if err != NotVerifiedError {
+				t.Fatalf("expected NotVerifiedError, got %v", err)
+			}
+			for i, result := range results {
+				if result == bad[i] {
+					t.Errorf("header %d: expected verified to be %v", i, !bad[i])
+				}
+			}
+		})
+	}
+}
+
+func TestBatchVerifyEmpty(t *testing.T) {
+	InitBLSCrypto()
+
+	if err := BatchVerifyEpochs(nil, true, true); err != EmptySliceError {
+		t.Errorf("BatchVerifyEpochs: expected EmptySliceError, got %v", err)
+	}
+	if _, err := BatchVerifyEpochsDetailed(nil, true, true); err != EmptySliceError {
+		t.Errorf("BatchVerifyEpochsDetailed: expected EmptySliceError, got %v", err)
+	}
+	if _, err := BatchVerifyStrict(nil, true, true); err != EmptySliceError {
+		t.Errorf("BatchVerifyStrict: expected EmptySliceError, got %v", err)
+	}
+	if _, err := BatchVerifyStrictWithThreads(nil, true, true, 0); err != EmptySliceError {
+		t.Errorf("BatchVerifyStrictWithThreads: expected EmptySliceError, got %v", err)
+	}
+
+	verifier := NewBatchVerifier()
+	defer verifier.Destroy()
+	if _, err := verifier.Verify(true, true); err != EmptySliceError {
+		t.Errorf("BatchVerifier.Verify: expected EmptySliceError, got %v", err)
+	}
+}
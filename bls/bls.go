@@ -1,12 +1,15 @@
 package bls
 
 /*
-#include "bls.h"
+#include "bls_ext.h"
 */
 import "C"
 
 import (
 	"errors"
+	"sync"
+	"sync/atomic"
+	"time"
 	"unsafe"
 )
 
@@ -18,6 +21,9 @@ const (
 	PUBLICKEYBYTES    = 96
 	SIGNATUREBYTES    = 48
 	EPOCHENTROPYBYTES = 16
+
+	// hashBytesHint is the expected size of the G1 hash outputs, which fits an uncompressed G1 point.
+	hashBytesHint = 2 * SIGNATUREBYTES
 )
 
 var (
@@ -61,8 +67,45 @@ func sliceToPtr(slice []byte) (*C.uchar, C.int) {
 	}
 }
 
+// writeInto calls one of the `*_into` functions with out as the destination buffer, and returns the written
+// prefix of out. out is grown to the expected output size before the call, since a retry recomputes the
+// whole output, and is only grown again if the output was longer than expected.
+func writeInto(out []byte, size int, call func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool) ([]byte, error) {
+	var written C.int
+	if cap(out) < size {
+		out = make([]byte, size)
+	}
+	out = out[:cap(out)]
+	outPtr, outCap := sliceToPtr(out)
+	success := call(outPtr, outCap, &written)
+	if !success && int(written) > len(out) {
+		out = make([]byte, int(written))
+		outPtr, outCap = sliceToPtr(out)
+		success = call(outPtr, outCap, &written)
+	}
+	if !success {
+		return nil, GeneralError
+	}
+
+	return out[:written], nil
+}
+
+// goBytesAndFree copies a vector returned by the library into Go memory and releases it with `free_vec`.
+func goBytesAndFree(bytes *C.uchar, size C.int) ([]byte, error) {
+	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
+	if !C.free_vec(bytes, size) {
+		return nil, GeneralError
+	}
+
+	return goBytes, nil
+}
+
 type PrivateKey struct {
 	ptr *C.struct_PrivateKey
+
+	// publicKeyMutex guards publicKey, the public key derived by the first ToPublic call
+	publicKeyMutex sync.Mutex
+	publicKey      *C.struct_PublicKey
 }
 
 type PublicKey struct {
@@ -97,8 +140,59 @@ type Batch struct {
 // to make prediction of future epoch message values infeasible.
 type EpochEntropy [EPOCHENTROPYBYTES]byte
 
+// InitState is the progress of the initialization of the lazily evaluated hashers.
+type InitState int32
+
+const (
+	InitNotStarted InitState = iota
+	InitRunning
+	InitDone
+)
+
+var (
+	initOnce  sync.Once
+	initState int32
+	initDone  = make(chan struct{})
+)
+
+func runInit() {
+	initOnce.Do(func() {
+		atomic.StoreInt32(&initState, int32(InitRunning))
+		C.init()
+		atomic.StoreInt32(&initState, int32(InitDone))
+		close(initDone)
+	})
+}
+
+// InitBLSCrypto initializes the lazily evaluated hashers, returning once they are ready.
 func InitBLSCrypto() {
-	C.init()
+	runInit()
+}
+
+// InitBLSCryptoAsync starts initializing the lazily evaluated hashers on a background goroutine and returns immediately,
+// so that startup can proceed while they warm up. Use InitStatus or InitWait to check for completion.
+func InitBLSCryptoAsync() {
+	atomic.CompareAndSwapInt32(&initState, int32(InitNotStarted), int32(InitRunning))
+	go runInit()
+}
+
+// InitStatus reports whether the hashers have been initialized.
+func InitStatus() InitState {
+	return InitState(atomic.LoadInt32(&initState))
+}
+
+// InitWait waits up to timeout for the initialization started by InitBLSCrypto or InitBLSCryptoAsync to finish.
+// It returns whether the hashers are ready.
+func InitWait(timeout time.Duration) bool {
+	timer := time.NewTimer(timeout)
+	defer timer.Stop()
+
+	select {
+	case <-initDone:
+		return true
+	case <-timer.C:
+		return false
+	}
 }
 
 func GeneratePrivateKey() (*PrivateKey, error) {
@@ -135,23 +229,25 @@ func (self *PrivateKey) Serialize() ([]byte, error) {
 	if !success {
 		return nil, GeneralError
 	}
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, GeneralError
-	}
 
-	return goBytes, nil
+	return goBytesAndFree(bytes, size)
 }
 
+// ToPublic returns the public key of the private key. The scalar multiplication is only done by the first call:
+// the derived key is kept with the private key, and later calls return a copy of it.
 func (self *PrivateKey) ToPublic() (*PublicKey, error) {
-	publicKey := &PublicKey{}
-	success := C.private_key_to_public_key(self.ptr, &publicKey.ptr)
-	if !success {
-		return nil, GeneralError
+	self.publicKeyMutex.Lock()
+	defer self.publicKeyMutex.Unlock()
+
+	if self.publicKey == nil {
+		success := C.private_key_to_public_key(self.ptr, &self.publicKey)
+		if !success {
+			self.publicKey = nil
+			return nil, GeneralError
+		}
 	}
 
-	return publicKey, nil
+	return clonePublicKey(self.publicKey)
 }
 
 func (self *PrivateKey) SignMessage(message []byte, extraData []byte, shouldUseCompositeHasher, shouldUseCIP22 bool) (*Signature, error) {
@@ -159,6 +255,7 @@ func (self *PrivateKey) SignMessage(message []byte, extraData []byte, shouldUseC
 	messagePtr, messageLen := sliceToPtr(message)
 	extraDataPtr, extraDataLen := sliceToPtr(extraData)
 
+	defer signMetrics.Record(time.Now())
 	success := C.sign_message(self.ptr, messagePtr, messageLen, extraDataPtr, extraDataLen, C.bool(shouldUseCompositeHasher), C.bool(shouldUseCIP22), &signature.ptr)
 	if !success {
 		return nil, GeneralError
@@ -170,6 +267,7 @@ func (self *PrivateKey) SignMessage(message []byte, extraData []byte, shouldUseC
 func (self *PrivateKey) SignPoP(message []byte) (*Signature, error) {
 	signature := &Signature{}
 	messagePtr, messageLen := sliceToPtr(message)
+	defer signMetrics.Record(time.Now())
 	success := C.sign_pop(self.ptr, messagePtr, messageLen, &signature.ptr)
 	if !success {
 		return nil, GeneralError
@@ -179,114 +277,117 @@ func (self *PrivateKey) SignPoP(message []byte) (*Signature, error) {
 }
 
 func HashDirect(message []byte, usePoP bool) ([]byte, error) {
+	return HashDirectInto(message, usePoP, nil)
+}
+
+// HashDirectInto is like HashDirect but writes the hash into out, which is grown if it is too small.
+func HashDirectInto(message []byte, usePoP bool, out []byte) ([]byte, error) {
 	messagePtr, messageLen := sliceToPtr(message)
-	var hashPtr *C.uchar
-	var hashLen C.int
-	success := C.hash_direct(messagePtr, messageLen, &hashPtr, &hashLen, C.bool(usePoP))
-	if !success {
-		return nil, GeneralError
-	}
-	hash := C.GoBytes(unsafe.Pointer(hashPtr), hashLen)
-	success = C.free_vec(hashPtr, hashLen)
-	if !success {
-		return nil, GeneralError
-	}
-	return hash, nil
+	return writeInto(out, hashBytesHint, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		defer hashMetrics.Record(time.Now())
+		return C.hash_direct_into(messagePtr, messageLen, C.bool(usePoP), outPtr, outCap, written)
+	})
 }
 
 func HashDirectWithAttempt(message []byte, usePoP bool) ([]byte, uint, error) {
+	return HashDirectWithAttemptInto(message, usePoP, nil)
+}
+
+// HashDirectWithAttemptInto is like HashDirectWithAttempt but writes the hash into out, which is grown if it is too small.
+func HashDirectWithAttemptInto(message []byte, usePoP bool, out []byte) ([]byte, uint, error) {
 	messagePtr, messageLen := sliceToPtr(message)
-	var hashPtr *C.uchar
-	var hashLen C.int
 	var attempt C.int
-	success := C.hash_direct_with_attempt(messagePtr, messageLen, &hashPtr, &hashLen, &attempt, C.bool(usePoP))
-	if !success {
-		return nil, 0, GeneralError
-	}
-	hash := C.GoBytes(unsafe.Pointer(hashPtr), hashLen)
-	success = C.free_vec(hashPtr, hashLen)
-	if !success {
-		return nil, 0, GeneralError
+	hash, err := writeInto(out, hashBytesHint, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		defer hashMetrics.Record(time.Now())
+		return C.hash_direct_with_attempt_into(messagePtr, messageLen, C.bool(usePoP), &attempt, outPtr, outCap, written)
+	})
+	if err != nil {
+		return nil, 0, err
 	}
 	return hash, uint(attempt), nil
 }
 
 func HashComposite(message []byte, extraData []byte) ([]byte, error) {
+	return HashCompositeInto(message, extraData, nil)
+}
+
+// HashCompositeInto is like HashComposite but writes the hash into out, which is grown if it is too small.
+func HashCompositeInto(message []byte, extraData []byte, out []byte) ([]byte, error) {
 	messagePtr, messageLen := sliceToPtr(message)
 	extraDataPtr, extraDataLen := sliceToPtr(extraData)
-	var hashLen C.int
-	var hashPtr *C.uchar
-	success := C.hash_composite(messagePtr, messageLen, extraDataPtr, extraDataLen, &hashPtr, &hashLen)
-	if !success {
-		return nil, GeneralError
-	}
-	hash := C.GoBytes(unsafe.Pointer(hashPtr), hashLen)
-	return hash, nil
+	return writeInto(out, hashBytesHint, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		defer hashMetrics.Record(time.Now())
+		return C.hash_composite_into(messagePtr, messageLen, extraDataPtr, extraDataLen, outPtr, outCap, written)
+	})
 }
 
 func HashDirectFirstStep(message []byte, hashBytes int32) ([]byte, error) {
+	return HashDirectFirstStepInto(message, hashBytes, nil)
+}
+
+// HashDirectFirstStepInto is like HashDirectFirstStep but writes the hash into out, which is grown if it is too small.
+func HashDirectFirstStepInto(message []byte, hashBytes int32, out []byte) ([]byte, error) {
 	messagePtr, messageLen := sliceToPtr(message)
-	var hashLen C.int
-	var hashPtr *C.uchar
-	success := C.hash_direct_first_step(messagePtr, messageLen, C.int(hashBytes), &hashPtr, &hashLen)
-	if !success {
-		return nil, GeneralError
-	}
-	hash := C.GoBytes(unsafe.Pointer(hashPtr), hashLen)
-	return hash, nil
+	return writeInto(out, int(hashBytes), func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		defer hashMetrics.Record(time.Now())
+		return C.hash_direct_first_step_into(messagePtr, messageLen, C.int(hashBytes), outPtr, outCap, written)
+	})
 }
 
 func HashCRH(message []byte, hashBytes int32) ([]byte, error) {
+	return HashCRHInto(message, hashBytes, nil)
+}
+
+// HashCRHInto is like HashCRH but writes the hash into out, which is grown if it is too small.
+func HashCRHInto(message []byte, hashBytes int32, out []byte) ([]byte, error) {
 	messagePtr, messageLen := sliceToPtr(message)
-	var hashLen C.int
-	var hashPtr *C.uchar
-	success := C.hash_crh(messagePtr, messageLen, C.int(hashBytes), &hashPtr, &hashLen)
-	if !success {
-		return nil, GeneralError
-	}
-	hash := C.GoBytes(unsafe.Pointer(hashPtr), hashLen)
-	return hash, nil
+	return writeInto(out, int(hashBytes), func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		defer hashMetrics.Record(time.Now())
+		return C.hash_crh_into(messagePtr, messageLen, C.int(hashBytes), outPtr, outCap, written)
+	})
 }
 
 func HashCompositeCIP22(message []byte, extraData []byte) ([]byte, uint8, error) {
+	return HashCompositeCIP22Into(message, extraData, nil)
+}
+
+// HashCompositeCIP22Into is like HashCompositeCIP22 but writes the hash into out, which is grown if it is too small.
+func HashCompositeCIP22Into(message []byte, extraData []byte, out []byte) ([]byte, uint8, error) {
 	messagePtr, messageLen := sliceToPtr(message)
 	extraDataPtr, extraDataLen := sliceToPtr(extraData)
-	var hashLen C.int
 	var attempts C.uchar
-	var hashPtr *C.uchar
-	success := C.hash_composite_cip22(messagePtr, messageLen, extraDataPtr, extraDataLen, &hashPtr, &hashLen, &attempts)
-	if !success {
-		return nil, 0, GeneralError
+	hash, err := writeInto(out, hashBytesHint, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		defer hashMetrics.Record(time.Now())
+		return C.hash_composite_cip22_into(messagePtr, messageLen, extraDataPtr, extraDataLen, &attempts, outPtr, outCap, written)
+	})
+	if err != nil {
+		return nil, 0, err
 	}
-	hash := C.GoBytes(unsafe.Pointer(hashPtr), hashLen)
 	return hash, uint8(attempts), nil
 }
 
 func CompressSignature(signature []byte) ([]byte, error) {
 	signaturePtr, signatureLen := sliceToPtr(signature)
-	var compressedLen C.int
-	var compressedPtr *C.uchar
-	success := C.compress_signature(signaturePtr, signatureLen, &compressedPtr, &compressedLen)
-	if !success {
-		return nil, GeneralError
-	}
-	compressedSignature := C.GoBytes(unsafe.Pointer(compressedPtr), compressedLen)
-	return compressedSignature, nil
+	return writeInto(nil, SIGNATUREBYTES, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		return C.compress_signature_into(signaturePtr, signatureLen, outPtr, outCap, written)
+	})
 }
 
 func CompressPublickey(pubkey []byte) ([]byte, error) {
 	pubkeyPtr, pubkeyLen := sliceToPtr(pubkey)
-	var compressedLen C.int
-	var compressedPtr *C.uchar
-	success := C.compress_pubkey(pubkeyPtr, pubkeyLen, &compressedPtr, &compressedLen)
-	if !success {
-		return nil, GeneralError
-	}
-	compressedPubkey := C.GoBytes(unsafe.Pointer(compressedPtr), compressedLen)
-	return compressedPubkey, nil
+	return writeInto(nil, PUBLICKEYBYTES, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		return C.compress_pubkey_into(pubkeyPtr, pubkeyLen, outPtr, outCap, written)
+	})
 }
 
 func (self *PrivateKey) Destroy() bool {
+	self.publicKeyMutex.Lock()
+	if self.publicKey != nil {
+		C.destroy_public_key(self.publicKey)
+		self.publicKey = nil
+	}
+	self.publicKeyMutex.Unlock()
+
 	return bool(C.destroy_private_key(self.ptr))
 }
 
@@ -299,6 +400,7 @@ func DeserializePublicKey(publicKeyBytes []byte) (*PublicKey, error) {
 	publicKeyPtr, publicKeyLen := sliceToPtr(publicKeyBytes)
 
 	publicKey := &PublicKey{}
+	defer deserializeMetrics.Record(time.Now())
 	success := C.deserialize_public_key(publicKeyPtr, publicKeyLen, &publicKey.ptr)
 	if !success {
 		return nil, GeneralError
@@ -307,53 +409,79 @@ func DeserializePublicKey(publicKeyBytes []byte) (*PublicKey, error) {
 	return publicKey, nil
 }
 
+// DeserializePublicKeyCached is like DeserializePublicKey, but reuses previously deserialized keys.
+// See PublicKeyCacheConfigure for controlling the cache.
 func DeserializePublicKeyCached(publicKeyBytes []byte) (*PublicKey, error) {
 	err := validatePublicKey(publicKeyBytes)
 	if err != nil {
 		return nil, err
 	}
 
-	publicKeyPtr, publicKeyLen := sliceToPtr(publicKeyBytes)
+	return publicKeyCache.deserialize(publicKeyBytes)
+}
 
-	publicKey := &PublicKey{}
-	success := C.deserialize_public_key_cached(publicKeyPtr, publicKeyLen, &publicKey.ptr)
-	if !success {
-		return nil, GeneralError
+// DeserializePublicKeys deserializes a contiguous buffer of public keys, each `PUBLICKEYBYTES` long.
+// The keys are split across GOMAXPROCS workers so that their subgroup checks run in parallel.
+// The error slice is nil if all keys were deserialized, otherwise it holds the error for each key and
+// the corresponding entries of the public key slice are nil. The last error is set instead, with both
+// slices nil, if the buffer is empty or not a whole number of keys.
+func DeserializePublicKeys(publicKeysBytes []byte) ([]*PublicKey, []error, error) {
+	if len(publicKeysBytes) == 0 {
+		return nil, nil, EmptySliceError
+	}
+	if len(publicKeysBytes)%PUBLICKEYBYTES != 0 {
+		return nil, nil, IncorrectSizeError
+	}
+
+	count := len(publicKeysBytes) / PUBLICKEYBYTES
+	publicKeysPtrs := make([]*C.struct_PublicKey, count)
+	cResults := make([]C.bool, count)
+	parallelChunks(count, func(start, end int) {
+		defer deserializeMetrics.Record(time.Now())
+		C.deserialize_public_keys_batch(
+			(*C.uchar)(unsafe.Pointer(&publicKeysBytes[start*PUBLICKEYBYTES])),
+			C.int(end-start),
+			&publicKeysPtrs[start],
+			&cResults[start],
+		)
+	})
+
+	publicKeys := make([]*PublicKey, count)
+	var errs []error
+	for i := 0; i < count; i++ {
+		if !cResults[i] {
+			if errs == nil {
+				errs = make([]error, count)
+			}
+			errs[i] = GeneralError
+			continue
+		}
+		publicKeys[i] = &PublicKey{ptr: publicKeysPtrs[i]}
 	}
 
-	return publicKey, nil
+	return publicKeys, errs, nil
 }
 
 func (self *PublicKey) Serialize() ([]byte, error) {
-	var bytes *C.uchar
-	var size C.int
-	success := C.serialize_public_key(self.ptr, &bytes, &size)
-	if !success {
-		return nil, GeneralError
-	}
+	return self.SerializeInto(nil)
+}
 
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, GeneralError
-	}
-	return goBytes, nil
+// SerializeInto writes the serialized public key into out, which is grown if it is too small, and returns the written bytes.
+func (self *PublicKey) SerializeInto(out []byte) ([]byte, error) {
+	return writeInto(out, PUBLICKEYBYTES, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		return C.serialize_public_key_into(self.ptr, outPtr, outCap, written)
+	})
 }
 
 func (self *PublicKey) SerializeUncompressed() ([]byte, error) {
-	var bytes *C.uchar
-	var size C.int
-	success := C.serialize_public_key_uncompressed(self.ptr, &bytes, &size)
-	if !success {
-		return nil, GeneralError
-	}
+	return self.SerializeUncompressedInto(nil)
+}
 
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, GeneralError
-	}
-	return goBytes, nil
+// SerializeUncompressedInto writes the uncompressed public key into out, which is grown if it is too small, and returns the written bytes.
+func (self *PublicKey) SerializeUncompressedInto(out []byte) ([]byte, error) {
+	return writeInto(out, 2*PUBLICKEYBYTES, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		return C.serialize_public_key_uncompressed_into(self.ptr, outPtr, outCap, written)
+	})
 }
 
 func (self *PublicKey) Destroy() bool {
@@ -372,31 +500,16 @@ func toBuffer(data []byte) C.Buffer {
 func BatchVerifyEpochs(signedHeaders []*SignedBlockHeader, shouldUseCompositeHasher, shouldUseCIP22 bool) error {
 	var verified C.bool
 	msg_len := len(signedHeaders)
-
-	// Allocate a contiguous slice of memory for the pointers
-	// NB: `make([]*C.MessageFFI, msg_len) results in `cgo argument has Go pointer to Go pointer`
-	size := int(unsafe.Sizeof(C.MessageFFI{}))
-	messages_ptr := C.malloc(C.size_t(size * msg_len))
-	defer C.free(messages_ptr)
-
-	// Get our data in the format the library expects
-	for i := 0; i < msg_len; i++ {
-		// convert the slices to pointers
-		data := toBuffer(signedHeaders[i].Data)
-		extra := toBuffer(signedHeaders[i].Extra)
-
-		// Get messages_ptr[i] (need to offset by i*size to take into account the size of C.MessageFFI)
-		msg := (*C.MessageFFI)(unsafe.Pointer(uintptr(messages_ptr) + uintptr(size*i)))
-		// ...and write to it
-		*msg = C.MessageFFI{
-			data:       data,
-			extra:      extra,
-			public_key: signedHeaders[i].Pubkey.ptr,
-			sig:        signedHeaders[i].Sig.ptr,
-		}
+	if msg_len == 0 {
+		return EmptySliceError
 	}
 
+	buffers := batchBuffersPool.Get().(*batchBuffers)
+	defer batchBuffersPool.Put(buffers)
+	messages_ptr := messagesToFFI(signedHeaders, &buffers.messages)
+
 	// make the batch verification call
+	defer batchVerifyMetrics.Record(time.Now())
 	success := C.batch_verify_signature(
 		(*C.MessageFFI)(messages_ptr),
 		C.int(msg_len),
@@ -416,74 +529,128 @@ func BatchVerifyEpochs(signedHeaders []*SignedBlockHeader, shouldUseCompositeHas
 	return nil
 }
 
-// BatchVerifyStrict verifies a group of signatures over a message. Unlike aggregated verification, it guarantees that each signer submitted a valid signature.
-// It returns a nil error if all verifications were successful. If there is an error, then the bool slice contains the individual results of each batch.
-func BatchVerifyStrict(batches []*Batch, shouldUseCompositeHasher, shouldUseCIP22 bool) ([]bool, error) {
-	var overallResult C.bool
+// BatchVerifyEpochsDetailed is like BatchVerifyEpochs, but locates the headers which failed to verify by bisecting the batch.
+// It returns a nil error if all headers verified, otherwise the bool slice contains the individual result of each header.
+func BatchVerifyEpochsDetailed(signedHeaders []*SignedBlockHeader, shouldUseCompositeHasher, shouldUseCIP22 bool) ([]bool, error) {
+	var verified C.bool
+	msg_len := len(signedHeaders)
+	if msg_len == 0 {
+		return nil, EmptySliceError
+	}
 
-	batchCount := len(batches)
-	cResults := make([]C.bool, batchCount)
+	buffers := batchBuffersPool.Get().(*batchBuffers)
+	defer batchBuffersPool.Put(buffers)
+	messages_ptr := messagesToFFI(signedHeaders, &buffers.messages)
 
-	// Allocate a contiguous slice of memory for the pointers
-	// NB: `make([]*C.MessageFFI, msg_len) results in `cgo argument has Go pointer to Go pointer`
-	size := int(unsafe.Sizeof(C.BatchMessageFFI{}))
-	messages_ptr := C.malloc(C.size_t(size * batchCount))
-	defer C.free(messages_ptr)
+	cResults := make([]C.bool, msg_len)
+	defer batchVerifyMetrics.Record(time.Now())
+	success := C.batch_verify_signature_detailed(
+		(*C.MessageFFI)(messages_ptr),
+		C.int(msg_len),
+		C.bool(shouldUseCompositeHasher),
+		C.bool(shouldUseCIP22),
+		&verified,
+		(*C.bool)(unsafe.Pointer(&cResults[0])),
+	)
 
-	// Put our data in the format the library expects
-	for i := 0; i < batchCount; i++ {
-		// convert the slices to pointers
-		data := toBuffer(batches[i].Data)
-		extra := toBuffer(batches[i].Extra)
+	if !success {
+		return nil, GeneralError
+	}
 
-		publicKeysPtrs := []*C.struct_PublicKey{}
-		for _, pk := range batches[i].Pubkeys {
-			if pk == nil {
-				continue
-			}
-			publicKeysPtrs = append(publicKeysPtrs, pk.ptr)
-		}
+	if !verified {
+		return toBoolSlice(cResults), NotVerifiedError
+	}
 
-		signaturesPtrs := []*C.struct_Signature{}
-		for _, sig := range batches[i].Sigs {
-			if sig == nil {
-				continue
-			}
-			signaturesPtrs = append(signaturesPtrs, sig.ptr)
-		}
+	return nil, nil
+}
+
+// messagesToFFI copies the signed headers into a `MessageFFI` array in the buffer.
+func messagesToFFI(signedHeaders []*SignedBlockHeader, buffer *cBuffer) unsafe.Pointer {
+	msg_len := len(signedHeaders)
+
+	// Use a contiguous slice of C memory for the pointers
+	// NB: `make([]*C.MessageFFI, msg_len) results in `cgo argument has Go pointer to Go pointer`
+	size := int(unsafe.Sizeof(C.MessageFFI{}))
+	messages_ptr := buffer.reserve(size * msg_len)
+
+	// Get our data in the format the library expects
+	for i := 0; i < msg_len; i++ {
+		// convert the slices to pointers
+		data := toBuffer(signedHeaders[i].Data)
+		extra := toBuffer(signedHeaders[i].Extra)
 
 		// Get messages_ptr[i] (need to offset by i*size to take into account the size of C.MessageFFI)
-		msg := (*C.BatchMessageFFI)(unsafe.Pointer(uintptr(messages_ptr) + uintptr(size*i)))
+		msg := (*C.MessageFFI)(unsafe.Pointer(uintptr(messages_ptr) + uintptr(size*i)))
 		// ...and write to it
-		*msg = C.BatchMessageFFI{
-			data:            data,
-			extra:           extra,
-			public_keys:     (**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])),
-			public_keys_len: C.int(len(publicKeysPtrs)),
-			signatures:      (**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[0])),
-			signatures_len:  C.int(len(signaturesPtrs)),
+		*msg = C.MessageFFI{
+			data:       data,
+			extra:      extra,
+			public_key: signedHeaders[i].Pubkey.ptr,
+			sig:        signedHeaders[i].Sig.ptr,
 		}
 	}
 
-	overallResult = C.batch_verify_strict(
-		(*C.BatchMessageFFI)(messages_ptr),
-		C.int(batchCount),
-		C.bool(shouldUseCompositeHasher),
-		C.bool(shouldUseCIP22),
-		(*C.bool)(unsafe.Pointer(&cResults[0])),
-	)
+	return messages_ptr
+}
+
+// BatchVerifyStrict verifies a group of signatures over a message. Unlike aggregated verification, it guarantees that each signer submitted a valid signature.
+// It returns a nil error if all verifications were successful. If there is an error, then the bool slice contains the individual results of each batch.
+func BatchVerifyStrict(batches []*Batch, shouldUseCompositeHasher, shouldUseCIP22 bool) ([]bool, error) {
+	if len(batches) == 0 {
+		return nil, EmptySliceError
+	}
+	cResults := make([]C.bool, len(batches))
+	overallResult := batchVerifyStrict(batches, shouldUseCompositeHasher, shouldUseCIP22, cResults)
 
 	if !overallResult {
-		outResults := make([]bool, len(cResults))
-		for i := 0; i < len(cResults); i++ {
-			outResults[i] = bool(cResults[i])
+		return toBoolSlice(cResults), NotVerifiedError
+	}
+
+	return nil, nil
+}
+
+// BatchVerifyStrictWithThreads is like BatchVerifyStrict, but splits the batches across at most maxThreads workers
+// of the pool configured by SetThreadPool, each verifying its share of the batches in one call.
+// A maxThreads of zero or less uses the whole pool.
+func BatchVerifyStrictWithThreads(batches []*Batch, shouldUseCompositeHasher, shouldUseCIP22 bool, maxThreads int) ([]bool, error) {
+	if len(batches) == 0 {
+		return nil, EmptySliceError
+	}
+	cResults := make([]C.bool, len(batches))
+	var failed int32
+	parallelChunksWith(len(batches), 1, maxThreads, func(start, end int) {
+		if !batchVerifyStrict(batches[start:end], shouldUseCompositeHasher, shouldUseCIP22, cResults[start:end]) {
+			atomic.StoreInt32(&failed, 1)
 		}
-		return outResults, NotVerifiedError
+	})
+
+	if failed != 0 {
+		return toBoolSlice(cResults), NotVerifiedError
 	}
 
 	return nil, nil
 }
 
+// batchVerifyStrict calls `batch_verify_strict` over the batches, writing the result of each batch to cResults.
+// An empty list of batches does not verify.
+func batchVerifyStrict(batches []*Batch, shouldUseCompositeHasher, shouldUseCIP22 bool, cResults []C.bool) bool {
+	if len(batches) == 0 {
+		return false
+	}
+	buffers := batchBuffersPool.Get().(*batchBuffers)
+	defer batchBuffersPool.Put(buffers)
+
+	return buffers.verify(batches, shouldUseCompositeHasher, shouldUseCIP22, cResults)
+}
+
+func toBoolSlice(cResults []C.bool) []bool {
+	outResults := make([]bool, len(cResults))
+	for i := 0; i < len(cResults); i++ {
+		outResults[i] = bool(cResults[i])
+	}
+	return outResults
+}
+
 func (self *PublicKey) VerifySignature(message []byte, extraData []byte, signature *Signature, shouldUseCompositeHasher, shouldUseCIP22 bool) error {
 	var verified C.bool
 
@@ -494,6 +661,7 @@ func (self *PublicKey) VerifySignature(message []byte, extraData []byte, signatu
 	messagePtr, messageLen := sliceToPtr(message)
 	extraDataPtr, extraDataLen := sliceToPtr(extraData)
 
+	defer verifyMetrics.Record(time.Now())
 	success := C.verify_signature(self.ptr, messagePtr, messageLen, extraDataPtr, extraDataLen, signature.ptr, C.bool(shouldUseCompositeHasher), C.bool(shouldUseCIP22), &verified)
 	if !success {
 		return GeneralError
@@ -513,6 +681,7 @@ func (self *PublicKey) VerifyPoP(message []byte, signature *Signature) error {
 	}
 
 	messagePtr, messageLen := sliceToPtr(message)
+	defer verifyMetrics.Record(time.Now())
 	success := C.verify_pop(self.ptr, messagePtr, messageLen, signature.ptr, &verified)
 	if !success {
 		return GeneralError
@@ -533,6 +702,7 @@ func DeserializeSignature(signatureBytes []byte) (*Signature, error) {
 	signaturePtr, signatureLen := sliceToPtr(signatureBytes)
 
 	signature := &Signature{}
+	defer deserializeMetrics.Record(time.Now())
 	success := C.deserialize_signature(signaturePtr, signatureLen, &signature.ptr)
 	if !success {
 		return nil, GeneralError
@@ -540,36 +710,69 @@ func DeserializeSignature(signatureBytes []byte) (*Signature, error) {
 	return signature, nil
 }
 
-func (self *Signature) Serialize() ([]byte, error) {
-	var bytes *C.uchar
-	var size C.int
-	success := C.serialize_signature(self.ptr, &bytes, &size)
-	if !success {
-		return nil, GeneralError
+// DeserializeSignatures deserializes a contiguous buffer of signatures, each `SIGNATUREBYTES` long.
+// The signatures are split across GOMAXPROCS workers so that their subgroup checks run in parallel.
+// The error slice is nil if all signatures were deserialized, otherwise it holds the error for each
+// signature and the corresponding entries of the signature slice are nil. The last error is set instead,
+// with both slices nil, if the buffer is empty or not a whole number of signatures.
+func DeserializeSignatures(signaturesBytes []byte) ([]*Signature, []error, error) {
+	if len(signaturesBytes) == 0 {
+		return nil, nil, EmptySliceError
 	}
-
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, GeneralError
+	if len(signaturesBytes)%SIGNATUREBYTES != 0 {
+		return nil, nil, IncorrectSizeError
+	}
+
+	count := len(signaturesBytes) / SIGNATUREBYTES
+	signaturesPtrs := make([]*C.struct_Signature, count)
+	cResults := make([]C.bool, count)
+	parallelChunks(count, func(start, end int) {
+		defer deserializeMetrics.Record(time.Now())
+		C.deserialize_signatures_batch(
+			(*C.uchar)(unsafe.Pointer(&signaturesBytes[start*SIGNATUREBYTES])),
+			C.int(end-start),
+			&signaturesPtrs[start],
+			&cResults[start],
+		)
+	})
+
+	signatures := make([]*Signature, count)
+	var errs []error
+	for i := 0; i < count; i++ {
+		if !cResults[i] {
+			if errs == nil {
+				errs = make([]error, count)
+			}
+			errs[i] = GeneralError
+			continue
+		}
+		signatures[i] = &Signature{ptr: signaturesPtrs[i]}
 	}
-	return goBytes, nil
+
+	return signatures, errs, nil
+}
+
+func (self *Signature) Serialize() ([]byte, error) {
+	return self.SerializeInto(nil)
+}
+
+// SerializeInto writes the serialized signature into out, which is grown if it is too small, and returns the written bytes.
+// Passing a reused buffer of `SIGNATUREBYTES` makes serialization allocation free on the Go side.
+func (self *Signature) SerializeInto(out []byte) ([]byte, error) {
+	return writeInto(out, SIGNATUREBYTES, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		return C.serialize_signature_into(self.ptr, outPtr, outCap, written)
+	})
 }
 
 func (self *Signature) SerializeUncompressed() ([]byte, error) {
-	var bytes *C.uchar
-	var size C.int
-	success := C.serialize_signature_uncompressed(self.ptr, &bytes, &size)
-	if !success {
-		return nil, GeneralError
-	}
+	return self.SerializeUncompressedInto(nil)
+}
 
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, GeneralError
-	}
-	return goBytes, nil
+// SerializeUncompressedInto writes the uncompressed signature into out, which is grown if it is too small, and returns the written bytes.
+func (self *Signature) SerializeUncompressedInto(out []byte) ([]byte, error) {
+	return writeInto(out, 2*SIGNATUREBYTES, func(outPtr *C.uchar, outCap C.int, written *C.int) C.bool {
+		return C.serialize_signature_uncompressed_into(self.ptr, outPtr, outCap, written)
+	})
 }
 
 func (self *Signature) Destroy() bool {
@@ -581,20 +784,14 @@ func AggregatePublicKeys(publicKeys []*PublicKey) (*PublicKey, error) {
 		return nil, EmptySliceError
 	}
 
-	publicKeysPtrs := []*C.struct_PublicKey{}
-	for _, pk := range publicKeys {
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(publicKeys))
+	for i, pk := range publicKeys {
 		if pk == nil {
 			return nil, NilPointerError
 		}
-		publicKeysPtrs = append(publicKeysPtrs, pk.ptr)
+		publicKeysPtrs[i] = pk.ptr
 	}
-	aggregatedPublicKey := &PublicKey{}
-	success := C.aggregate_public_keys((**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])), C.int(len(publicKeysPtrs)), &aggregatedPublicKey.ptr)
-	if !success {
-		return nil, GeneralError
-	}
-
-	return aggregatedPublicKey, nil
+	return aggregatePublicKeysPtrs(publicKeysPtrs)
 }
 
 func AggregatePublicKeysSubtract(aggregatedPublicKey *PublicKey, publicKeys []*PublicKey) (*PublicKey, error) {
@@ -606,14 +803,15 @@ func AggregatePublicKeysSubtract(aggregatedPublicKey *PublicKey, publicKeys []*P
 		return nil, EmptySliceError
 	}
 
-	publicKeysPtrs := []*C.struct_PublicKey{}
-	for _, pk := range publicKeys {
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(publicKeys))
+	for i, pk := range publicKeys {
 		if pk == nil {
 			return nil, NilPointerError
 		}
-		publicKeysPtrs = append(publicKeysPtrs, pk.ptr)
+		publicKeysPtrs[i] = pk.ptr
 	}
 	subtractedPublicKey := &PublicKey{}
+	defer aggregateMetrics.Record(time.Now())
 	success := C.aggregate_public_keys_subtract(aggregatedPublicKey.ptr, (**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])), C.int(len(publicKeysPtrs)), &subtractedPublicKey.ptr)
 	if !success {
 		return nil, GeneralError
@@ -627,20 +825,14 @@ func AggregateSignatures(signatures []*Signature) (*Signature, error) {
 		return nil, EmptySliceError
 	}
 
-	signaturesPtrs := []*C.struct_Signature{}
-	for _, sig := range signatures {
+	signaturesPtrs := make([]*C.struct_Signature, len(signatures))
+	for i, sig := range signatures {
 		if sig == nil {
 			return nil, NilPointerError
 		}
-		signaturesPtrs = append(signaturesPtrs, sig.ptr)
+		signaturesPtrs[i] = sig.ptr
 	}
-	aggregatedSignature := &Signature{}
-	success := C.aggregate_signatures((**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[0])), C.int(len(signaturesPtrs)), &aggregatedSignature.ptr)
-	if !success {
-		return nil, GeneralError
-	}
-
-	return aggregatedSignature, nil
+	return aggregateSignaturesPtrs(signaturesPtrs)
 }
 
 func encodeEpochToBytesCIP22(epochIndex uint16, round uint8, blockHash, parentHash EpochEntropy, maximumNonSigners, maximumValidators uint32, addedPublicKeys []*PublicKey) ([]byte, []byte, error) {
@@ -648,12 +840,12 @@ func encodeEpochToBytesCIP22(epochIndex uint16, round uint8, blockHash, parentHa
 		return nil, nil, EmptySliceError
 	}
 
-	publicKeysPtrs := []*C.struct_PublicKey{}
-	for _, pk := range addedPublicKeys {
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(addedPublicKeys))
+	for i, pk := range addedPublicKeys {
 		if pk == nil {
 			return nil, nil, NilPointerError
 		}
-		publicKeysPtrs = append(publicKeysPtrs, pk.ptr)
+		publicKeysPtrs[i] = pk.ptr
 	}
 
 	blockHashPtr := (*C.uchar)(&blockHash[0])
@@ -681,15 +873,14 @@ func encodeEpochToBytesCIP22(epochIndex uint16, round uint8, blockHash, parentHa
 		return nil, nil, GeneralError
 	}
 
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, nil, GeneralError
+	goBytes, err := goBytesAndFree(bytes, size)
+	if err != nil {
+		C.free_vec(extraDataBytes, extraDataSize)
+		return nil, nil, err
 	}
-	goExtraDataBytes := C.GoBytes(unsafe.Pointer(extraDataBytes), extraDataSize)
-	success = C.free_vec(extraDataBytes, extraDataSize)
-	if !success {
-		return nil, nil, GeneralError
+	goExtraDataBytes, err := goBytesAndFree(extraDataBytes, extraDataSize)
+	if err != nil {
+		return nil, nil, err
 	}
 	return goBytes, goExtraDataBytes, nil
 }
@@ -699,12 +890,12 @@ func encodeEpochToBytes(epochIndex uint16, maximumNonSigners uint32, addedPublic
 		return nil, EmptySliceError
 	}
 
-	publicKeysPtrs := []*C.struct_PublicKey{}
-	for _, pk := range addedPublicKeys {
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(addedPublicKeys))
+	for i, pk := range addedPublicKeys {
 		if pk == nil {
 			return nil, NilPointerError
 		}
-		publicKeysPtrs = append(publicKeysPtrs, pk.ptr)
+		publicKeysPtrs[i] = pk.ptr
 	}
 
 	var bytes *C.uchar
@@ -721,12 +912,7 @@ func encodeEpochToBytes(epochIndex uint16, maximumNonSigners uint32, addedPublic
 		return nil, GeneralError
 	}
 
-	goBytes := C.GoBytes(unsafe.Pointer(bytes), size)
-	success = C.free_vec(bytes, size)
-	if !success {
-		return nil, GeneralError
-	}
-	return goBytes, nil
+	return goBytesAndFree(bytes, size)
 }
 
 func EncodeEpochToBytesCIP22(epochIndex uint16, round uint8, blockHash, parentHash EpochEntropy, maximumNonSigners, maximumValidators uint32, addedPublicKeys []*PublicKey) ([]byte, []byte, error) {
@@ -0,0 +1,196 @@
+// +build windows
+
+package bls
+
+import (
+	"fmt"
+	"testing"
+)
+
+// hashers are the hasher configurations exercised by the benchmarks
+var hashers = []struct {
+	name                     string
+	shouldUseCompositeHasher bool
+	shouldUseCIP22           bool
+}{
+	{"direct", false, false},
+	{"composite", true, false},
+	{"cip22", true, true},
+}
+
+var batchSizes = []int{1, 10, 100, 1000}
+
+// validatorSetSizes covers small committees up to large validator sets
+var validatorSetSizes = []int{10, 100, 150, 1000, 10000}
+
+const benchSignersPerMessage = 4
+
+var (
+	benchMessage   = []byte("benchmark message")
+	benchExtraData = []byte("benchmark extra data")
+)
+
+func BenchmarkSignMessage(b *testing.B) {
+	signers := newSigners(b, 1)
+	defer destroySigners(signers)
+
+	for _, hasher := range hashers {
+		b.Run(hasher.name, func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				sign(b, signers[0].privateKey, benchMessage, benchExtraData, hasher.shouldUseCompositeHasher, hasher.shouldUseCIP22).Destroy()
+			}
+		})
+	}
+}
+
+func BenchmarkVerifySignature(b *testing.B) {
+	signers := newSigners(b, 1)
+	defer destroySigners(signers)
+
+	for _, hasher := range hashers {
+		b.Run(hasher.name, func(b *testing.B) {
+			signature := sign(b, signers[0].privateKey, benchMessage, benchExtraData, hasher.shouldUseCompositeHasher, hasher.shouldUseCIP22)
+			defer signature.Destroy()
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				err := signers[0].publicKey.VerifySignature(benchMessage, benchExtraData, signature, hasher.shouldUseCompositeHasher, hasher.shouldUseCIP22)
+				if err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkBatchVerifyEpochs verifies epoch headers which are each signed over a different message
+func BenchmarkBatchVerifyEpochs(b *testing.B) {
+	signers := newSigners(b, batchSizes[len(batchSizes)-1])
+	defer destroySigners(signers)
+
+	for _, size := range batchSizes {
+		b.Run(fmt.Sprint(size), func(b *testing.B) {
+			headers := make([]*SignedBlockHeader, size)
+			for i := range headers {
+				message := []byte(fmt.Sprintf("epoch %d", i))
+				headers[i] = &SignedBlockHeader{
+					Data:   message,
+					Extra:  benchExtraData,
+					Pubkey: signers[i].publicKey,
+					Sig:    sign(b, signers[i].privateKey, message, benchExtraData, true, true),
+				}
+			}
+			defer func() {
+				for _, header := range headers {
+					header.Sig.Destroy()
+				}
+			}()
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if err := BatchVerifyEpochs(headers, true, true); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkBatchVerifyStrict verifies messages which are each signed by benchSignersPerMessage validators
+func BenchmarkBatchVerifyStrict(b *testing.B) {
+	signers := newSigners(b, benchSignersPerMessage)
+	defer destroySigners(signers)
+
+	for _, size := range batchSizes {
+		b.Run(fmt.Sprint(size), func(b *testing.B) {
+			batches := make([]*Batch, size)
+			for i := range batches {
+				message := []byte(fmt.Sprintf("message %d", i))
+				batch := &Batch{Data: message, Extra: benchExtraData}
+				for _, signer := range signers {
+					batch.Pubkeys = append(batch.Pubkeys, signer.publicKey)
+					batch.Sigs = append(batch.Sigs, sign(b, signer.privateKey, message, benchExtraData, true, true))
+				}
+				batches[i] = batch
+			}
+			defer func() {
+				for _, batch := range batches {
+					for _, sig := range batch.Sigs {
+						sig.Destroy()
+					}
+				}
+			}()
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if _, err := BatchVerifyStrict(batches, true, true); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+func BenchmarkAggregatePublicKeys(b *testing.B) {
+	// Larger sets reuse the keys, which costs the same to aggregate as distinct keys
+	signers := newSigners(b, 100)
+	defer destroySigners(signers)
+
+	for _, size := range validatorSetSizes {
+		b.Run(fmt.Sprint(size), func(b *testing.B) {
+			publicKeys := make([]*PublicKey, size)
+			for i := range publicKeys {
+				publicKeys[i] = signers[i%len(signers)].publicKey
+			}
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				aggregatedPublicKey, err := AggregatePublicKeys(publicKeys)
+				if err != nil {
+					b.Fatal(err)
+				}
+				aggregatedPublicKey.Destroy()
+			}
+		})
+	}
+}
+
+func BenchmarkHash(b *testing.B) {
+	InitBLSCrypto()
+
+	hashes := []struct {
+		name string
+		hash func() error
+	}{
+		{"HashDirect", func() error {
+			_, err := HashDirect(benchMessage, false)
+			return err
+		}},
+		{"HashComposite", func() error {
+			_, err := HashComposite(benchMessage, benchExtraData)
+			return err
+		}},
+		{"HashCompositeCIP22", func() error {
+			_, _, err := HashCompositeCIP22(benchMessage, benchExtraData)
+			return err
+		}},
+		{"HashDirectFirstStep", func() error {
+			_, err := HashDirectFirstStep(benchMessage, 32)
+			return err
+		}},
+		{"HashCRH", func() error {
+			_, err := HashCRH(benchMessage, 32)
+			return err
+		}},
+	}
+
+	for _, hash := range hashes {
+		b.Run(hash.name, func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if err := hash.hash(); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
@@ -0,0 +1,420 @@
+#include "bls_ext.h"
+
+#include <string.h>
+
+#define PUBLICKEYBYTES 96
+#define SIGNATUREBYTES 48
+
+/*
+ * Copies a vector returned by the library into the caller's buffer and frees it.
+ */
+static bool copy_vec_into(bool success, uint8_t *vec, int vec_len, uint8_t *out_bytes, int out_cap, int *out_written) {
+  if (!success) {
+    return false;
+  }
+  *out_written = vec_len;
+  bool fits = vec_len <= out_cap;
+  if (fits && vec_len > 0) {
+    memcpy(out_bytes, vec, (size_t)vec_len);
+  }
+  return free_vec(vec, vec_len) && fits;
+}
+
+bool deserialize_public_keys_batch(const uint8_t *in_public_keys_bytes,
+                                   int in_public_keys_len,
+                                   PublicKey **out_public_keys,
+                                   bool *out_results) {
+  bool all = true;
+  for (int i = 0; i < in_public_keys_len; i++) {
+    const uint8_t *bytes = in_public_keys_bytes + (size_t)i * PUBLICKEYBYTES;
+    out_public_keys[i] = NULL;
+    out_results[i] = deserialize_public_key(bytes, PUBLICKEYBYTES, &out_public_keys[i]);
+    all = all && out_results[i];
+  }
+  return all;
+}
+
+bool deserialize_signatures_batch(const uint8_t *in_signatures_bytes,
+                                  int in_signatures_len,
+                                  Signature **out_signatures,
+                                  bool *out_results) {
+  bool all = true;
+  for (int i = 0; i < in_signatures_len; i++) {
+    const uint8_t *bytes = in_signatures_bytes + (size_t)i * SIGNATUREBYTES;
+    out_signatures[i] = NULL;
+    out_results[i] = deserialize_signature(bytes, SIGNATUREBYTES, &out_signatures[i]);
+    all = all && out_results[i];
+  }
+  return all;
+}
+
+bool serialize_public_key_into(const PublicKey *in_public_key,
+                               uint8_t *out_bytes,
+                               int out_cap,
+                               int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = serialize_public_key(in_public_key, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool serialize_public_key_uncompressed_into(const PublicKey *in_public_key,
+                                            uint8_t *out_bytes,
+                                            int out_cap,
+                                            int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = serialize_public_key_uncompressed(in_public_key, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool serialize_signature_into(const Signature *in_signature,
+                              uint8_t *out_bytes,
+                              int out_cap,
+                              int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = serialize_signature(in_signature, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool serialize_signature_uncompressed_into(const Signature *in_signature,
+                                           uint8_t *out_bytes,
+                                           int out_cap,
+                                           int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = serialize_signature_uncompressed(in_signature, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool hash_direct_into(const uint8_t *in_message,
+                      int in_message_len,
+                      bool use_pop,
+                      uint8_t *out_bytes,
+                      int out_cap,
+                      int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = hash_direct(in_message, in_message_len, &vec, &vec_len, use_pop);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool hash_direct_with_attempt_into(const uint8_t *in_message,
+                                   int in_message_len,
+                                   bool use_pop,
+                                   int *out_attempt,
+                                   uint8_t *out_bytes,
+                                   int out_cap,
+                                   int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = hash_direct_with_attempt(in_message, in_message_len, &vec, &vec_len, out_attempt, use_pop);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool hash_composite_into(const uint8_t *in_message,
+                         int in_message_len,
+                         const uint8_t *in_extra_data,
+                         int in_extra_data_len,
+                         uint8_t *out_bytes,
+                         int out_cap,
+                         int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = hash_composite(in_message, in_message_len, in_extra_data, in_extra_data_len, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool hash_direct_first_step_into(const uint8_t *in_message,
+                                 int in_message_len,
+                                 int hash_bytes,
+                                 uint8_t *out_bytes,
+                                 int out_cap,
+                                 int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = hash_direct_first_step(in_message, in_message_len, hash_bytes, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool hash_crh_into(const uint8_t *in_message,
+                   int in_message_len,
+                   int hash_bytes,
+                   uint8_t *out_bytes,
+                   int out_cap,
+                   int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = hash_crh(in_message, in_message_len, hash_bytes, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool hash_composite_cip22_into(const uint8_t *in_message,
+                               int in_message_len,
+                               const uint8_t *in_extra_data,
+                               int in_extra_data_len,
+                               uint8_t *out_attempts,
+                               uint8_t *out_bytes,
+                               int out_cap,
+                               int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = hash_composite_cip22(in_message, in_message_len, in_extra_data, in_extra_data_len, &vec, &vec_len, out_attempts);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool compress_pubkey_into(const uint8_t *in_pubkey,
+                          int in_pubkey_len,
+                          uint8_t *out_bytes,
+                          int out_cap,
+                          int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = compress_pubkey(in_pubkey, in_pubkey_len, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+bool compress_signature_into(const uint8_t *in_signature,
+                             int in_signature_len,
+                             uint8_t *out_bytes,
+                             int out_cap,
+                             int *out_written) {
+  uint8_t *vec = NULL;
+  int vec_len = 0;
+  bool success = compress_signature(in_signature, in_signature_len, &vec, &vec_len);
+  return copy_vec_into(success, vec, vec_len, out_bytes, out_cap, out_written);
+}
+
+static bool verify_or_bisect(const MessageFFI *messages_ptr,
+                             int messages_len,
+                             bool should_use_composite,
+                             bool should_use_cip22,
+                             bool *out_results);
+
+/*
+ * Locates the invalid messages of a range which is known to not verify. Only the left half is
+ * batch verified: if it verifies, the invalid messages are all in the right half, which is
+ * bisected without being verified as a whole again.
+ */
+static bool bisect_batch_verify_signature(const MessageFFI *messages_ptr,
+                                          int messages_len,
+                                          bool should_use_composite,
+                                          bool should_use_cip22,
+                                          bool *out_results) {
+  if (messages_len == 1) {
+    out_results[0] = false;
+    return true;
+  }
+
+  int half = messages_len / 2;
+  bool left_verified = false;
+  if (!batch_verify_signature(messages_ptr, half, should_use_composite, should_use_cip22, &left_verified)) {
+    return false;
+  }
+  if (left_verified) {
+    for (int i = 0; i < half; i++) {
+      out_results[i] = true;
+    }
+    return bisect_batch_verify_signature(messages_ptr + half, messages_len - half, should_use_composite,
+                                         should_use_cip22, out_results + half);
+  }
+  return bisect_batch_verify_signature(messages_ptr, half, should_use_composite, should_use_cip22, out_results) &&
+         verify_or_bisect(messages_ptr + half, messages_len - half, should_use_composite, should_use_cip22,
+                          out_results + half);
+}
+
+/* Batch verifies a range whose validity is unknown, bisecting it if it does not verify. */
+static bool verify_or_bisect(const MessageFFI *messages_ptr,
+                             int messages_len,
+                             bool should_use_composite,
+                             bool should_use_cip22,
+                             bool *out_results) {
+  bool verified = false;
+  if (!batch_verify_signature(messages_ptr, messages_len, should_use_composite, should_use_cip22, &verified)) {
+    return false;
+  }
+  if (!verified) {
+    return bisect_batch_verify_signature(messages_ptr, messages_len, should_use_composite, should_use_cip22,
+                                         out_results);
+  }
+  for (int i = 0; i < messages_len; i++) {
+    out_results[i] = true;
+  }
+  return true;
+}
+
+bool batch_verify_signature_detailed(const MessageFFI *messages_ptr,
+                                     int messages_len,
+                                     bool should_use_composite,
+                                     bool should_use_cip22,
+                                     bool *verified,
+                                     bool *out_results) {
+  if (messages_len <= 0) {
+    return false;
+  }
+  if (!verify_or_bisect(messages_ptr, messages_len, should_use_composite, should_use_cip22, out_results)) {
+    return false;
+  }
+  *verified = true;
+  for (int i = 0; i < messages_len; i++) {
+    *verified = *verified && out_results[i];
+  }
+  return true;
+}
+
+bool aggregate_public_keys_many(const PublicKey *const *in_public_keys,
+                                const int *in_group_lens,
+                                int in_groups_len,
+                                PublicKey **out_public_keys) {
+  const PublicKey *const *group = in_public_keys;
+  for (int i = 0; i < in_groups_len; i++) {
+    if (!aggregate_public_keys(group, in_group_lens[i], &out_public_keys[i])) {
+      for (int j = 0; j < i; j++) {
+        destroy_public_key(out_public_keys[j]);
+        out_public_keys[j] = NULL;
+      }
+      return false;
+    }
+    group += in_group_lens[i];
+  }
+  return true;
+}
+
+bool aggregate_signatures_many(const Signature *const *in_signatures,
+                               const int *in_group_lens,
+                               int in_groups_len,
+                               Signature **out_signatures) {
+  const Signature *const *group = in_signatures;
+  for (int i = 0; i < in_groups_len; i++) {
+    if (!aggregate_signatures(group, in_group_lens[i], &out_signatures[i])) {
+      for (int j = 0; j < i; j++) {
+        destroy_signature(out_signatures[j]);
+        out_signatures[j] = NULL;
+      }
+      return false;
+    }
+    group += in_group_lens[i];
+  }
+  return true;
+}
+
+bool sign_messages_multi(const PrivateKey *const *in_private_keys,
+                         const SignMessageFFI *in_messages,
+                         int in_messages_len,
+                         bool should_use_composite,
+                         bool should_use_cip22,
+                         Signature **out_signatures) {
+  for (int i = 0; i < in_messages_len; i++) {
+    const SignMessageFFI *message = &in_messages[i];
+    if (!sign_message(in_private_keys[i], message->data.ptr, message->data.len, message->extra.ptr, message->extra.len,
+                      should_use_composite, should_use_cip22, &out_signatures[i])) {
+      for (int j = 0; j < i; j++) {
+        destroy_signature(out_signatures[j]);
+        out_signatures[j] = NULL;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sign_messages_batch(const PrivateKey *in_private_key,
+                         const SignMessageFFI *in_messages,
+                         int in_messages_len,
+                         bool should_use_composite,
+                         bool should_use_cip22,
+                         Signature **out_signatures) {
+  for (int i = 0; i < in_messages_len; i++) {
+    const SignMessageFFI *message = &in_messages[i];
+    if (!sign_message(in_private_key, message->data.ptr, message->data.len, message->extra.ptr, message->extra.len,
+                      should_use_composite, should_use_cip22, &out_signatures[i])) {
+      for (int j = 0; j < i; j++) {
+        destroy_signature(out_signatures[j]);
+        out_signatures[j] = NULL;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+bool hash_composite_cip22_batch(const SignMessageFFI *in_messages,
+                                int in_messages_len,
+                                uint8_t *out_hashes,
+                                int out_stride,
+                                int *out_lens,
+                                uint8_t *out_attempts) {
+  for (int i = 0; i < in_messages_len; i++) {
+    const SignMessageFFI *message = &in_messages[i];
+    if (!hash_composite_cip22_into(message->data.ptr, message->data.len, message->extra.ptr, message->extra.len,
+                                   &out_attempts[i], out_hashes + (size_t)i * out_stride, out_stride, &out_lens[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool hash_crh_batch(const Buffer *in_messages,
+                    int in_messages_len,
+                    int hash_bytes,
+                    uint8_t *out_hashes,
+                    int out_stride,
+                    int *out_lens) {
+  for (int i = 0; i < in_messages_len; i++) {
+    if (!hash_crh_into(in_messages[i].ptr, in_messages[i].len, hash_bytes, out_hashes + (size_t)i * out_stride,
+                       out_stride, &out_lens[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool hash_direct_first_step_batch(const Buffer *in_messages,
+                                  int in_messages_len,
+                                  int hash_bytes,
+                                  uint8_t *out_hashes,
+                                  int out_stride,
+                                  int *out_lens) {
+  for (int i = 0; i < in_messages_len; i++) {
+    if (!hash_direct_first_step_into(in_messages[i].ptr, in_messages[i].len, hash_bytes,
+                                     out_hashes + (size_t)i * out_stride, out_stride, &out_lens[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool deserialize_public_key_96(const uint8_t (*in_public_key_bytes)[BLS_PUBLIC_KEY_BYTES],
+                               PublicKey **out_public_key) {
+  return deserialize_public_key(*in_public_key_bytes, BLS_PUBLIC_KEY_BYTES, out_public_key);
+}
+
+bool deserialize_signature_48(const uint8_t (*in_signature_bytes)[BLS_SIGNATURE_BYTES],
+                              Signature **out_signature) {
+  return deserialize_signature(*in_signature_bytes, BLS_SIGNATURE_BYTES, out_signature);
+}
+
+bool verify_signature_raw(const uint8_t (*in_public_key_bytes)[BLS_PUBLIC_KEY_BYTES],
+                          const uint8_t *in_message,
+                          int in_message_len,
+                          const uint8_t *in_extra_data,
+                          int in_extra_data_len,
+                          const uint8_t (*in_signature_bytes)[BLS_SIGNATURE_BYTES],
+                          bool should_use_composite,
+                          bool should_use_cip22,
+                          bool *out_verified) {
+  PublicKey *public_key = NULL;
+  Signature *signature = NULL;
+  bool success = deserialize_public_key_96(in_public_key_bytes, &public_key) &&
+                 deserialize_signature_48(in_signature_bytes, &signature) &&
+                 verify_signature(public_key, in_message, in_message_len, in_extra_data, in_extra_data_len,
+                                  signature, should_use_composite, should_use_cip22, out_verified);
+  if (signature != NULL) {
+    destroy_signature(signature);
+  }
+  if (public_key != NULL) {
+    destroy_public_key(public_key);
+  }
+  return success;
+}
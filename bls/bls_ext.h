@@ -0,0 +1,376 @@
+#ifndef BLS_EXT_H
+#define BLS_EXT_H
+
+#include "bls.h"
+
+/*
+ * Helpers layered on top of the `libbls_snark_sys` exports declared in `bls.h`.
+ *
+ * They are compiled together with the Go package and only call the exported
+ * functions, so that loops over many elements cost a single cgo crossing.
+ */
+
+/**
+ * Deserializes `in_public_keys_len` public keys stored back to back in
+ * `in_public_keys_bytes`, each `PUBLICKEYBYTES` long.
+ *
+ * `out_public_keys[i]` is set to NULL and `out_results[i]` to false for every
+ * key which failed to deserialize. Returns true if all keys deserialized.
+ */
+bool deserialize_public_keys_batch(const uint8_t *in_public_keys_bytes,
+                                   int in_public_keys_len,
+                                   PublicKey **out_public_keys,
+                                   bool *out_results);
+
+/**
+ * Deserializes `in_signatures_len` signatures stored back to back in
+ * `in_signatures_bytes`, each `SIGNATUREBYTES` long.
+ *
+ * `out_signatures[i]` is set to NULL and `out_results[i]` to false for every
+ * signature which failed to deserialize. Returns true if all signatures deserialized.
+ */
+bool deserialize_signatures_batch(const uint8_t *in_signatures_bytes,
+                                  int in_signatures_len,
+                                  Signature **out_signatures,
+                                  bool *out_results);
+
+/**
+ * The `*_into` functions write their output into the caller provided `out_bytes`
+ * buffer of capacity `out_cap` instead of returning a vector which must be freed
+ * with `free_vec`.
+ *
+ * `out_written` is always set to the length of the output. If it exceeds `out_cap`
+ * nothing is written and false is returned, so that the caller can retry with a
+ * large enough buffer.
+ */
+bool serialize_public_key_into(const PublicKey *in_public_key,
+                               uint8_t *out_bytes,
+                               int out_cap,
+                               int *out_written);
+
+bool serialize_public_key_uncompressed_into(const PublicKey *in_public_key,
+                                            uint8_t *out_bytes,
+                                            int out_cap,
+                                            int *out_written);
+
+bool serialize_signature_into(const Signature *in_signature,
+                              uint8_t *out_bytes,
+                              int out_cap,
+                              int *out_written);
+
+bool serialize_signature_uncompressed_into(const Signature *in_signature,
+                                           uint8_t *out_bytes,
+                                           int out_cap,
+                                           int *out_written);
+
+bool hash_direct_into(const uint8_t *in_message,
+                      int in_message_len,
+                      bool use_pop,
+                      uint8_t *out_bytes,
+                      int out_cap,
+                      int *out_written);
+
+bool hash_direct_with_attempt_into(const uint8_t *in_message,
+                                   int in_message_len,
+                                   bool use_pop,
+                                   int *out_attempt,
+                                   uint8_t *out_bytes,
+                                   int out_cap,
+                                   int *out_written);
+
+bool hash_composite_into(const uint8_t *in_message,
+                         int in_message_len,
+                         const uint8_t *in_extra_data,
+                         int in_extra_data_len,
+                         uint8_t *out_bytes,
+                         int out_cap,
+                         int *out_written);
+
+bool hash_direct_first_step_into(const uint8_t *in_message,
+                                 int in_message_len,
+                                 int hash_bytes,
+                                 uint8_t *out_bytes,
+                                 int out_cap,
+                                 int *out_written);
+
+bool hash_crh_into(const uint8_t *in_message,
+                   int in_message_len,
+                   int hash_bytes,
+                   uint8_t *out_bytes,
+                   int out_cap,
+                   int *out_written);
+
+bool hash_composite_cip22_into(const uint8_t *in_message,
+                               int in_message_len,
+                               const uint8_t *in_extra_data,
+                               int in_extra_data_len,
+                               uint8_t *out_attempts,
+                               uint8_t *out_bytes,
+                               int out_cap,
+                               int *out_written);
+
+bool compress_pubkey_into(const uint8_t *in_pubkey,
+                          int in_pubkey_len,
+                          uint8_t *out_bytes,
+                          int out_cap,
+                          int *out_written);
+
+bool compress_signature_into(const uint8_t *in_signature,
+                             int in_signature_len,
+                             uint8_t *out_bytes,
+                             int out_cap,
+                             int *out_written);
+
+/**
+ * A validator set keeps the public keys of an epoch together with their cached
+ * aggregate, so that the aggregate public key of any subset of signers can be
+ * computed without rebuilding the key list.
+ *
+ * A set may be read concurrently, but must not be modified while it is read.
+ */
+typedef struct ValidatorSet ValidatorSet;
+
+/**
+ * Creates a validator set from `in_public_keys_len` public keys.
+ * The set takes ownership of the public keys, which must not be destroyed by the caller.
+ */
+bool validator_set_create(PublicKey *const *in_public_keys,
+                          int in_public_keys_len,
+                          ValidatorSet **out_validator_set);
+
+/**
+ * Deserializes a public key and appends it to the validator set.
+ */
+bool validator_set_add(ValidatorSet *validator_set,
+                       const uint8_t *in_public_key_bytes,
+                       int in_public_key_bytes_len);
+
+/**
+ * Removes the public key at `index`. The keys after it are shifted down by one.
+ */
+bool validator_set_remove(ValidatorSet *validator_set, int index);
+
+bool validator_set_len(const ValidatorSet *validator_set, int *out_len);
+
+/**
+ * Returns the aggregate public key of the signers in the bitmap, where bit `i % 8`
+ * of byte `i / 8` is set if the validator at index `i` signed.
+ *
+ * The aggregate is computed with at most min(signers, non-signers) point additions,
+ * by subtracting the non-signers from the cached aggregate when they are fewer.
+ */
+bool validator_set_aggregate_signers(const ValidatorSet *validator_set,
+                                     const uint8_t *in_bitmap,
+                                     int in_bitmap_len,
+                                     PublicKey **out_public_key);
+
+bool destroy_validator_set(ValidatorSet *validator_set);
+
+/**
+ * Verifies an aggregated seal in a single call: aggregates the public keys of the
+ * signers in the bitmap (see `validator_set_aggregate_signers`), deserializes the
+ * aggregated signature and verifies it over the data/extra pair.
+ *
+ * The intermediate public key and signature are released before returning.
+ */
+bool verify_aggregated_seal(const ValidatorSet *validator_set,
+                            const uint8_t *in_bitmap,
+                            int in_bitmap_len,
+                            const uint8_t *in_message,
+                            int in_message_len,
+                            const uint8_t *in_extra_data,
+                            int in_extra_data_len,
+                            const uint8_t *in_signature_bytes,
+                            int in_signature_bytes_len,
+                            bool should_use_composite,
+                            bool should_use_cip22,
+                            bool *out_verified);
+
+/**
+ * Like `batch_verify_signature`, but also reports which messages failed to verify.
+ *
+ * If the whole batch does not verify, it is bisected recursively. Only the left
+ * half of a failed range is batch verified: if it verifies, the right half must
+ * fail and is bisected without being verified as a whole. A single invalid
+ * message out of n is thus located with log2(n) batch verifications over about
+ * n messages in total, and k invalid messages with O(k log n) batch verifications.
+ * `out_results[i]` is set to whether the message at index `i` verified.
+ */
+bool batch_verify_signature_detailed(const MessageFFI *messages_ptr,
+                                     int messages_len,
+                                     bool should_use_composite,
+                                     bool should_use_cip22,
+                                     bool *verified,
+                                     bool *out_results);
+
+/**
+ * Aggregates several independent groups of public keys in one call. The groups are
+ * stored back to back in `in_public_keys`, group `i` being `in_group_lens[i]` long,
+ * and its aggregate is written to `out_public_keys[i]`.
+ *
+ * On failure no aggregate is returned.
+ */
+bool aggregate_public_keys_many(const PublicKey *const *in_public_keys,
+                                const int *in_group_lens,
+                                int in_groups_len,
+                                PublicKey **out_public_keys);
+
+/**
+ * Aggregates several independent groups of signatures in one call, laid out like
+ * the groups of `aggregate_public_keys_many`.
+ */
+bool aggregate_signatures_many(const Signature *const *in_signatures,
+                               const int *in_group_lens,
+                               int in_groups_len,
+                               Signature **out_signatures);
+
+/**
+ * Computes the multi-scalar multiplication `sum(scalars[i] * points[i])` of
+ * `in_len` points with Pippenger's bucket method, the window size being chosen
+ * from `in_len`.
+ *
+ * Each scalar is 32 bytes long and little-endian, in the same format as a
+ * serialized private key. The scalars are stored back to back in `in_scalars`.
+ *
+ * The buckets are summed with the exported aggregation functions. As the identity
+ * is not a valid public key or signature, a result at infinity is a failure. It is
+ * detected with one more point addition and the serialization of two points.
+ */
+bool public_keys_msm(const PublicKey *const *in_public_keys,
+                     const uint8_t *in_scalars,
+                     int in_len,
+                     PublicKey **out_public_key);
+
+bool signatures_msm(const Signature *const *in_signatures,
+                    const uint8_t *in_scalars,
+                    int in_len,
+                    Signature **out_signature);
+
+/**
+ * A message to be signed, with the extra data signed alongside it
+ */
+typedef struct {
+  Buffer data;
+  Buffer extra;
+} SignMessageFFI;
+
+/**
+ * Signs `in_messages_len` messages with the same private key.
+ *
+ * On failure no signature is returned.
+ */
+bool sign_messages_batch(const PrivateKey *in_private_key,
+                         const SignMessageFFI *in_messages,
+                         int in_messages_len,
+                         bool should_use_composite,
+                         bool should_use_cip22,
+                         Signature **out_signatures);
+
+/**
+ * Signs message `i` with private key `i`, for `in_messages_len` pairs.
+ *
+ * On failure no signature is returned.
+ */
+bool sign_messages_multi(const PrivateKey *const *in_private_keys,
+                         const SignMessageFFI *in_messages,
+                         int in_messages_len,
+                         bool should_use_composite,
+                         bool should_use_cip22,
+                         Signature **out_signatures);
+
+/**
+ * An arena owns the public keys and signatures allocated through it, and
+ * releases all of them at once when it is destroyed. Handles allocated in an
+ * arena must not be destroyed individually.
+ *
+ * An arena must not be used concurrently.
+ */
+typedef struct Arena Arena;
+
+bool bls_arena_create(Arena **out_arena);
+
+bool bls_arena_deserialize_public_key(Arena *arena,
+                                      const uint8_t *in_public_key_bytes,
+                                      int in_public_key_bytes_len,
+                                      PublicKey **out_public_key);
+
+bool bls_arena_deserialize_signature(Arena *arena,
+                                     const uint8_t *in_signature_bytes,
+                                     int in_signature_bytes_len,
+                                     Signature **out_signature);
+
+bool bls_arena_aggregate_public_keys(Arena *arena,
+                                     const PublicKey *const *in_public_keys,
+                                     int in_public_keys_len,
+                                     PublicKey **out_public_key);
+
+bool bls_arena_aggregate_signatures(Arena *arena,
+                                    const Signature *const *in_signatures,
+                                    int in_signatures_len,
+                                    Signature **out_signature);
+
+/**
+ * Destroys the arena and every handle allocated in it.
+ */
+bool bls_arena_destroy(Arena *arena);
+
+/**
+ * The `*_batch` hash functions hash `in_messages_len` messages in one call.
+ * Hash `i` is written at `out_hashes + i * out_stride` and its length to
+ * `out_lens[i]`. They fail if any hash fails or is longer than `out_stride`,
+ * in which case its required length is still written to `out_lens[i]`.
+ */
+bool hash_composite_cip22_batch(const SignMessageFFI *in_messages,
+                                int in_messages_len,
+                                uint8_t *out_hashes,
+                                int out_stride,
+                                int *out_lens,
+                                uint8_t *out_attempts);
+
+bool hash_crh_batch(const Buffer *in_messages,
+                    int in_messages_len,
+                    int hash_bytes,
+                    uint8_t *out_hashes,
+                    int out_stride,
+                    int *out_lens);
+
+bool hash_direct_first_step_batch(const Buffer *in_messages,
+                                  int in_messages_len,
+                                  int hash_bytes,
+                                  uint8_t *out_hashes,
+                                  int out_stride,
+                                  int *out_lens);
+
+/**
+ * Sizes of the serialized compressed points, matching `PUBLICKEYBYTES` and
+ * `SIGNATUREBYTES` on the Go side.
+ */
+#define BLS_PUBLIC_KEY_BYTES 96
+#define BLS_SIGNATURE_BYTES 48
+
+/**
+ * Fixed-size variants of `deserialize_public_key` and `deserialize_signature`.
+ * The length is part of the type, so it is not passed or checked at runtime.
+ */
+bool deserialize_public_key_96(const uint8_t (*in_public_key_bytes)[BLS_PUBLIC_KEY_BYTES],
+                               PublicKey **out_public_key);
+
+bool deserialize_signature_48(const uint8_t (*in_signature_bytes)[BLS_SIGNATURE_BYTES],
+                              Signature **out_signature);
+
+/**
+ * Verifies a serialized signature over the data/extra pair against a serialized
+ * public key in a single call. The intermediate handles are released before
+ * returning, so nothing has to be destroyed by the caller.
+ */
+bool verify_signature_raw(const uint8_t (*in_public_key_bytes)[BLS_PUBLIC_KEY_BYTES],
+                          const uint8_t *in_message,
+                          int in_message_len,
+                          const uint8_t *in_extra_data,
+                          int in_extra_data_len,
+                          const uint8_t (*in_signature_bytes)[BLS_SIGNATURE_BYTES],
+                          bool should_use_composite,
+                          bool should_use_cip22,
+                          bool *out_verified);
+
+#endif
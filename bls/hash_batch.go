@@ -0,0 +1,150 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"sync/atomic"
+	"time"
+	"unsafe"
+)
+
+// minHashChunkSize is the smallest number of messages hashed by a single worker.
+const minHashChunkSize = 4
+
+// splitHashes slices the hashes written with a fixed stride into one slice per message.
+func splitHashes(hashes []byte, stride int, lens []C.int) [][]byte {
+	out := make([][]byte, len(lens))
+	for i, hashLen := range lens {
+		out[i] = hashes[i*stride : i*stride+int(hashLen) : i*stride+int(hashLen)]
+	}
+	return out
+}
+
+// requiredStride returns the longest hash length reported by a failed batch if it did not fit in the stride, or
+// zero if the batch failed for another reason.
+func requiredStride(stride int, lens []C.int) int {
+	required := 0
+	for _, hashLen := range lens {
+		if int(hashLen) > stride && int(hashLen) > required {
+			required = int(hashLen)
+		}
+	}
+	return required
+}
+
+// buffersToFFI copies the messages into a `Buffer` array in the buffer.
+func buffersToFFI(messages [][]byte, buffer *cBuffer) unsafe.Pointer {
+	size := int(unsafe.Sizeof(C.Buffer{}))
+	buffersPtr := buffer.reserve(size * len(messages))
+	for i, message := range messages {
+		*(*C.Buffer)(unsafe.Pointer(uintptr(buffersPtr) + uintptr(size*i))) = toBuffer(message)
+	}
+	return buffersPtr
+}
+
+// HashCompositeCIP22Batch hashes many message/extra data pairs like HashCompositeCIP22, spreading the try-and-increment
+// hashing across the worker pool. It returns the hash and the number of attempts of each message.
+func HashCompositeCIP22Batch(messages []Message) ([][]byte, []uint8, error) {
+	if len(messages) == 0 {
+		return nil, nil, EmptySliceError
+	}
+
+	// SignMessageFFI is the data/extra pair laid out like all other message arrays
+	messagesPtr := signMessagesToFFI(messages)
+	defer C.free(messagesPtr)
+	size := uintptr(unsafe.Sizeof(C.SignMessageFFI{}))
+
+	// A hash longer than the stride fails the batch, which is then retried with the reported length
+	for stride := hashBytesHint; stride != 0; {
+		hashes := make([]byte, len(messages)*stride)
+		lens := make([]C.int, len(messages))
+		attempts := make([]C.uchar, len(messages))
+		var failed int32
+		parallelChunksWith(len(messages), minHashChunkSize, 0, func(start, end int) {
+			defer hashMetrics.Record(time.Now())
+			success := C.hash_composite_cip22_batch(
+				(*C.SignMessageFFI)(unsafe.Pointer(uintptr(messagesPtr)+size*uintptr(start))),
+				C.int(end-start),
+				(*C.uchar)(unsafe.Pointer(&hashes[start*stride])),
+				C.int(stride),
+				&lens[start],
+				&attempts[start],
+			)
+			if !success {
+				atomic.StoreInt32(&failed, 1)
+			}
+		})
+		if failed != 0 {
+			stride = requiredStride(stride, lens)
+			continue
+		}
+
+		outAttempts := make([]uint8, len(attempts))
+		for i, attempt := range attempts {
+			outAttempts[i] = uint8(attempt)
+		}
+		return splitHashes(hashes, stride, lens), outAttempts, nil
+	}
+
+	return nil, nil, GeneralError
+}
+
+// HashCRHBatch hashes many messages like HashCRH, spread across the worker pool.
+func HashCRHBatch(messages [][]byte, hashBytes int32) ([][]byte, error) {
+	return hashBatch(messages, hashBytes, func(messagesPtr *C.Buffer, messagesLen C.int, hashesPtr *C.uchar, stride C.int, lensPtr *C.int) C.bool {
+		return C.hash_crh_batch(messagesPtr, messagesLen, C.int(hashBytes), hashesPtr, stride, lensPtr)
+	})
+}
+
+// HashDirectFirstStepBatch hashes many messages like HashDirectFirstStep, spread across the worker pool.
+func HashDirectFirstStepBatch(messages [][]byte, hashBytes int32) ([][]byte, error) {
+	return hashBatch(messages, hashBytes, func(messagesPtr *C.Buffer, messagesLen C.int, hashesPtr *C.uchar, stride C.int, lensPtr *C.int) C.bool {
+		return C.hash_direct_first_step_batch(messagesPtr, messagesLen, C.int(hashBytes), hashesPtr, stride, lensPtr)
+	})
+}
+
+func hashBatch(messages [][]byte, hashBytes int32, call func(messagesPtr *C.Buffer, messagesLen C.int, hashesPtr *C.uchar, stride C.int, lensPtr *C.int) C.bool) ([][]byte, error) {
+	if len(messages) == 0 {
+		return nil, EmptySliceError
+	}
+	if hashBytes <= 0 {
+		return nil, IncorrectSizeError
+	}
+
+	buffers := batchBuffersPool.Get().(*batchBuffers)
+	defer batchBuffersPool.Put(buffers)
+	messagesPtr := buffersToFFI(messages, &buffers.messages)
+	size := uintptr(unsafe.Sizeof(C.Buffer{}))
+
+	// A hash longer than the stride fails the batch, which is then retried with the reported length, the way
+	// writeInto grows the buffer of the single message functions
+	for stride := int(hashBytes); stride != 0; {
+		hashes := make([]byte, len(messages)*stride)
+		lens := make([]C.int, len(messages))
+		var failed int32
+		parallelChunksWith(len(messages), minHashChunkSize, 0, func(start, end int) {
+			defer hashMetrics.Record(time.Now())
+			success := call(
+				(*C.Buffer)(unsafe.Pointer(uintptr(messagesPtr)+size*uintptr(start))),
+				C.int(end-start),
+				(*C.uchar)(unsafe.Pointer(&hashes[start*stride])),
+				C.int(stride),
+				&lens[start],
+			)
+			if !success {
+				atomic.StoreInt32(&failed, 1)
+			}
+		})
+		if failed != 0 {
+			stride = requiredStride(stride, lens)
+			continue
+		}
+
+		return splitHashes(hashes, stride, lens), nil
+	}
+
+	return nil, GeneralError
+}
@@ -0,0 +1,100 @@
+// +build windows
+
+package bls
+
+import (
+	"bytes"
+	"fmt"
+	"testing"
+)
+
+func hashMessages(n int) [][]byte {
+	messages := make([][]byte, n)
+	for i := range messages {
+		messages[i] = []byte(fmt.Sprintf("message %d", i))
+	}
+	return messages
+}
+
+func TestHashBatch(t *testing.T) {
+	InitBLSCrypto()
+	// Enough messages to be split across workers
+	messages := hashMessages(4*minHashChunkSize + 1)
+
+	for _, hashBytes := range []int32{32, 64} {
+		crh, err := HashCRHBatch(messages, hashBytes)
+		if err != nil {
+			t.Fatal(err)
+		}
+		firstStep, err := HashDirectFirstStepBatch(messages, hashBytes)
+		if err != nil {
+			t.Fatal(err)
+		}
+		for i, message := range messages {
+			expected, err := HashCRH(message, hashBytes)
+			if err != nil {
+				t.Fatal(err)
+			}
+			if !bytes.Equal(crh[i], expected) {
+				t.Errorf("HashCRHBatch(%d) differs from HashCRH at %d", hashBytes, i)
+			}
+			expected, err = HashDirectFirstStep(message, hashBytes)
+			if err != nil {
+				t.Fatal(err)
+			}
+			if !bytes.Equal(firstStep[i], expected) {
+				t.Errorf("HashDirectFirstStepBatch(%d) differs from HashDirectFirstStep at %d", hashBytes, i)
+			}
+		}
+	}
+
+	signMessages := make([]Message, len(messages))
+	for i, message := range messages {
+		signMessages[i] = Message{Data: message, Extra: []byte("extra")}
+	}
+	hashes, attempts, err := HashCompositeCIP22Batch(signMessages)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i, message := range signMessages {
+		expected, expectedAttempts, err := HashCompositeCIP22(message.Data, message.Extra)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !bytes.Equal(hashes[i], expected) || attempts[i] != expectedAttempts {
+			t.Errorf("HashCompositeCIP22Batch differs from HashCompositeCIP22 at %d", i)
+		}
+	}
+}
+
+func TestHashInto(t *testing.T) {
+	InitBLSCrypto()
+	message := []byte("message")
+
+	expected, err := HashDirect(message, false)
+	if err != nil {
+		t.Fatal(err)
+	}
+	// A buffer too small for the hash is grown
+	for _, out := range [][]byte{nil, make([]byte, 1), make([]byte, 0, 2*hashBytesHint)} {
+		hash, err := HashDirectInto(message, false, out)
+		if err != nil {
+			t.Fatal(err)
+		}
+		if !bytes.Equal(hash, expected) {
+			t.Errorf("HashDirectInto with a buffer of %d bytes differs from HashDirect", cap(out))
+		}
+	}
+
+	expected, err = HashCRH(message, 32)
+	if err != nil {
+		t.Fatal(err)
+	}
+	hash, err := HashCRHInto(message, 32, make([]byte, 8))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(hash, expected) {
+		t.Error("HashCRHInto with a short buffer differs from HashCRH")
+	}
+}
@@ -0,0 +1,136 @@
+// +build windows
+
+package bls
+
+import (
+	"runtime"
+	"runtime/debug"
+	"syscall"
+	"testing"
+	"unsafe"
+)
+
+// PROCESS_MEMORY_COUNTERS_EX from psapi.h
+type processMemoryCounters struct {
+	cb                         uint32
+	pageFaultCount             uint32
+	peakWorkingSetSize         uintptr
+	workingSetSize             uintptr
+	quotaPeakPagedPoolUsage    uintptr
+	quotaPagedPoolUsage        uintptr
+	quotaPeakNonPagedPoolUsage uintptr
+	quotaNonPagedPoolUsage     uintptr
+	pagefileUsage              uintptr
+	peakPagefileUsage          uintptr
+	privateUsage               uintptr
+}
+
+var getProcessMemoryInfo = syscall.NewLazyDLL("psapi.dll").NewProc("GetProcessMemoryInfo")
+
+// privateBytes returns the private bytes of the process after releasing the Go heap, so that it
+// mostly measures native allocations.
+func privateBytes(t *testing.T) uintptr {
+	runtime.GC()
+	debug.FreeOSMemory()
+
+	process, err := syscall.GetCurrentProcess()
+	if err != nil {
+		t.Fatal(err)
+	}
+	var counters processMemoryCounters
+	counters.cb = uint32(unsafe.Sizeof(counters))
+	ret, _, err := getProcessMemoryInfo.Call(uintptr(process), uintptr(unsafe.Pointer(&counters)), uintptr(counters.cb))
+	if ret == 0 {
+		t.Fatal(err)
+	}
+	return counters.privateUsage
+}
+
+// TestVectorOutputsDoNotLeak calls every wrapper which used to copy a library vector without freeing it,
+// and checks that the private bytes of the process stay flat.
+func TestVectorOutputsDoNotLeak(t *testing.T) {
+	if testing.Short() {
+		t.Skip("skipping leak test in short mode")
+	}
+	InitBLSCrypto()
+
+	privateKey, err := GeneratePrivateKey()
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer privateKey.Destroy()
+	publicKey, err := privateKey.ToPublic()
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer publicKey.Destroy()
+	signature, err := privateKey.SignMessage([]byte("message"), []byte("extra"), true, false)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer signature.Destroy()
+
+	uncompressedPublicKey, err := publicKey.SerializeUncompressed()
+	if err != nil {
+		t.Fatal(err)
+	}
+	uncompressedSignature, err := signature.SerializeUncompressed()
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	message := []byte("leak test message")
+	extraData := []byte("leak test extra data")
+	calls := map[string]func() error{
+		"HashComposite": func() error {
+			_, err := HashComposite(message, extraData)
+			return err
+		},
+		"HashDirectFirstStep": func() error {
+			_, err := HashDirectFirstStep(message, 32)
+			return err
+		},
+		"HashCRH": func() error {
+			_, err := HashCRH(message, 32)
+			return err
+		},
+		"HashCompositeCIP22": func() error {
+			_, _, err := HashCompositeCIP22(message, extraData)
+			return err
+		},
+		"CompressSignature": func() error {
+			_, err := CompressSignature(uncompressedSignature)
+			return err
+		},
+		"CompressPublickey": func() error {
+			_, err := CompressPublickey(uncompressedPublicKey)
+			return err
+		},
+	}
+
+	// A leaked vector of even 32 bytes per call grows the process by several MiB over the iterations
+	const iterations = 200000
+	const maxGrowth = 2 << 20
+	for name, call := range calls {
+		t.Run(name, func(t *testing.T) {
+			// warm up the allocators and the hasher parameters
+			for i := 0; i < 1000; i++ {
+				if err := call(); err != nil {
+					t.Fatal(err)
+				}
+			}
+
+			before := privateBytes(t)
+			for i := 0; i < iterations; i++ {
+				if err := call(); err != nil {
+					t.Fatal(err)
+				}
+			}
+			after := privateBytes(t)
+
+			if after > before+maxGrowth {
+				t.Errorf("private bytes grew from %d to %d over %d calls", before, after, iterations)
+			}
+		})
+	}
+}
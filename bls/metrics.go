@@ -0,0 +1,59 @@
+package bls
+
+import (
+	"github.com/celo-org/celo-bls-go-windows/internal/metrics"
+)
+
+// The number and cumulative duration of the native calls of an operation
+type OperationMetrics = metrics.Snapshot
+
+// Metrics of the native calls made by this package, grouped by operation.
+//
+// Each cgo call into the library counts once: a batch call counts as one call, while the chunks of a
+// parallel call count separately and their durations add up. The durations therefore measure the
+// time spent in the library across all threads, which may exceed the wall time.
+type Metrics struct {
+	// Signing, including proofs of possession
+	Sign OperationMetrics
+	// Individual signature and aggregated seal verifications
+	Verify OperationMetrics
+	// Batch verifications, including the bisection of failed batches
+	BatchVerify OperationMetrics
+	// Public key and signature aggregation, including multi-scalar multiplications
+	Aggregate OperationMetrics
+	// Hashing to the curve and its intermediate steps
+	Hash OperationMetrics
+	// Public key and signature deserialization
+	Deserialize OperationMetrics
+}
+
+var (
+	signMetrics        metrics.Timer
+	verifyMetrics      metrics.Timer
+	batchVerifyMetrics metrics.Timer
+	aggregateMetrics   metrics.Timer
+	hashMetrics        metrics.Timer
+	deserializeMetrics metrics.Timer
+)
+
+// GetMetrics returns the metrics accumulated since the process started or ResetMetrics was last called.
+func GetMetrics() Metrics {
+	return Metrics{
+		Sign:        signMetrics.Snapshot(),
+		Verify:      verifyMetrics.Snapshot(),
+		BatchVerify: batchVerifyMetrics.Snapshot(),
+		Aggregate:   aggregateMetrics.Snapshot(),
+		Hash:        hashMetrics.Snapshot(),
+		Deserialize: deserializeMetrics.Snapshot(),
+	}
+}
+
+// ResetMetrics sets all metrics back to zero.
+func ResetMetrics() {
+	signMetrics.Reset()
+	verifyMetrics.Reset()
+	batchVerifyMetrics.Reset()
+	aggregateMetrics.Reset()
+	hashMetrics.Reset()
+	deserializeMetrics.Reset()
+}
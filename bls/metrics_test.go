@@ -0,0 +1,42 @@
+// +build windows
+
+package bls
+
+import (
+	"testing"
+)
+
+func TestMetricsCountNativeCalls(t *testing.T) {
+	InitBLSCrypto()
+
+	privateKey, err := GeneratePrivateKey()
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer privateKey.Destroy()
+
+	ResetMetrics()
+	for i := 0; i < 3; i++ {
+		signature, err := privateKey.SignMessage([]byte("message"), []byte("extra"), true, true)
+		if err != nil {
+			t.Fatal(err)
+		}
+		signature.Destroy()
+	}
+
+	metrics := GetMetrics()
+	if metrics.Sign.Calls != 3 {
+		t.Errorf("expected 3 sign calls, got %d", metrics.Sign.Calls)
+	}
+	if metrics.Sign.Nanoseconds == 0 {
+		t.Error("expected the sign calls to be timed")
+	}
+	if metrics.Verify.Calls != 0 {
+		t.Errorf("expected no verify calls, got %d", metrics.Verify.Calls)
+	}
+
+	ResetMetrics()
+	if metrics := GetMetrics(); metrics.Sign.Calls != 0 || metrics.Sign.Nanoseconds != 0 {
+		t.Errorf("expected the metrics to be reset, got %+v", metrics.Sign)
+	}
+}
@@ -0,0 +1,247 @@
+#include "bls_ext.h"
+
+#include <string.h>
+
+#define SCALAR_BYTES 32
+#define SCALAR_BITS (8 * SCALAR_BYTES)
+#define MAX_WINDOW_BITS 16
+
+/*
+ * The group operations exported by the library, over either public keys or signatures.
+ * Points are opaque handles. The accumulators of this file are NULL until a point is added
+ * to them, but a sum of points which cancel out is a non-NULL handle to the identity.
+ */
+typedef struct {
+  bool (*sum)(const void *const *points, int len, void **out);
+  bool (*destroy)(void *point);
+  bool (*serialize)(const void *point, uint8_t **out_bytes, int *out_len);
+} group_ops;
+
+static bool public_key_sum(const void *const *points, int len, void **out) {
+  return aggregate_public_keys((const PublicKey *const *)points, len, (PublicKey **)out);
+}
+
+static bool public_key_destroy(void *point) {
+  return destroy_public_key((PublicKey *)point);
+}
+
+static bool public_key_serialize(const void *point, uint8_t **out_bytes, int *out_len) {
+  return serialize_public_key((const PublicKey *)point, out_bytes, out_len);
+}
+
+static bool signature_sum(const void *const *points, int len, void **out) {
+  return aggregate_signatures((const Signature *const *)points, len, (Signature **)out);
+}
+
+static bool signature_destroy(void *point) {
+  return destroy_signature((Signature *)point);
+}
+
+static bool signature_serialize(const void *point, uint8_t **out_bytes, int *out_len) {
+  return serialize_signature((const Signature *)point, out_bytes, out_len);
+}
+
+static const group_ops public_key_ops = {public_key_sum, public_key_destroy, public_key_serialize};
+static const group_ops signature_ops = {signature_sum, signature_destroy, signature_serialize};
+
+/* Compares two points by their serialization. */
+static bool same_point(const group_ops *ops, const void *a, const void *b, bool *out_same) {
+  uint8_t *a_bytes = NULL, *b_bytes = NULL;
+  int a_len = 0, b_len = 0;
+  bool success = ops->serialize(a, &a_bytes, &a_len) && ops->serialize(b, &b_bytes, &b_len);
+  if (success) {
+    *out_same = a_len == b_len && memcmp(a_bytes, b_bytes, (size_t)a_len) == 0;
+  }
+  if (a_bytes != NULL) {
+    free_vec(a_bytes, a_len);
+  }
+  if (b_bytes != NULL) {
+    free_vec(b_bytes, b_len);
+  }
+  return success;
+}
+
+/*
+ * Checks whether point is the identity, as the library has no such query: the identity is
+ * the only point p for which p + q == q, for any q.
+ */
+static bool is_identity(const group_ops *ops, const void *point, const void *q, bool *out_identity) {
+  void *sum = NULL;
+  const void *pair[2] = {point, q};
+  if (!ops->sum(pair, 2, &sum)) {
+    return false;
+  }
+  bool success = same_point(ops, sum, q, out_identity);
+  ops->destroy(sum);
+  return success;
+}
+
+/* Replaces *acc by *acc + point, taking a copy of point if *acc is the identity. */
+static bool acc_add(const group_ops *ops, void **acc, const void *point) {
+  if (point == NULL) {
+    return true;
+  }
+  void *result = NULL;
+  if (*acc == NULL) {
+    if (!ops->sum(&point, 1, &result)) {
+      return false;
+    }
+  } else {
+    const void *pair[2] = {*acc, point};
+    if (!ops->sum(pair, 2, &result)) {
+      return false;
+    }
+    ops->destroy(*acc);
+  }
+  *acc = result;
+  return true;
+}
+
+/* Replaces *acc by 2 * *acc. */
+static bool acc_double(const group_ops *ops, void **acc) {
+  if (*acc == NULL) {
+    return true;
+  }
+  void *result = NULL;
+  const void *pair[2] = {*acc, *acc};
+  if (!ops->sum(pair, 2, &result)) {
+    return false;
+  }
+  ops->destroy(*acc);
+  *acc = result;
+  return true;
+}
+
+static int window_bits(int len) {
+  if (len < 32) {
+    return 3;
+  }
+  /* ln(len) + 2, the usual choice for Pippenger's method */
+  int log2 = 0;
+  while ((1 << (log2 + 1)) <= len) {
+    log2++;
+  }
+  int bits = log2 * 69 / 100 + 2;
+  return bits > MAX_WINDOW_BITS ? MAX_WINDOW_BITS : bits;
+}
+
+static unsigned scalar_digit(const uint8_t *scalar, int start, int bits) {
+  unsigned digit = 0;
+  for (int i = 0; i < bits && start + i < SCALAR_BITS; i++) {
+    int bit = start + i;
+    digit |= (unsigned)((scalar[bit / 8] >> (bit % 8)) & 1) << i;
+  }
+  return digit;
+}
+
+/*
+ * Pippenger's bucket method: for every window of `c` bits, the points are sorted into
+ * 2^c - 1 buckets by their digit and each bucket is summed in a single aggregation.
+ * The window sum `sum(b * bucket[b])` is then formed with running sums, and the
+ * windows are combined from the most significant one with `c` doublings between each.
+ */
+static bool msm(const group_ops *ops, const void *const *points, const uint8_t *scalars, int len, void **out) {
+  if (len <= 0) {
+    return false;
+  }
+  int c = window_bits(len);
+  int num_buckets = (1 << c) - 1;
+  int num_windows = (SCALAR_BITS + c - 1) / c;
+
+  int *counts = calloc((size_t)num_buckets + 1, sizeof(int));
+  int *digits = malloc((size_t)len * sizeof(int));
+  const void **sorted = malloc((size_t)len * sizeof(void *));
+  void **bucket_sums = calloc((size_t)num_buckets + 1, sizeof(void *));
+  void *result = NULL;
+  bool success = counts != NULL && digits != NULL && sorted != NULL && bucket_sums != NULL;
+
+  for (int w = num_windows - 1; success && w >= 0; w--) {
+    /* Counting sort of the points by their digit in this window; counts[b] ends as the start of bucket b */
+    for (int b = 0; b <= num_buckets; b++) {
+      counts[b] = 0;
+    }
+    for (int i = 0; i < len; i++) {
+      digits[i] = (int)scalar_digit(scalars + (size_t)i * SCALAR_BYTES, w * c, c);
+      counts[digits[i]]++;
+    }
+    int offset = 0;
+    for (int b = 0; b <= num_buckets; b++) {
+      int count = counts[b];
+      counts[b] = offset;
+      offset += count;
+    }
+    for (int i = 0; i < len; i++) {
+      sorted[counts[digits[i]]++] = points[i];
+    }
+    /* counts[b] now holds the end of bucket b */
+    for (int b = 1; success && b <= num_buckets; b++) {
+      int start = counts[b - 1];
+      int bucket_len = counts[b] - start;
+      bucket_sums[b] = NULL;
+      if (bucket_len > 0) {
+        success = ops->sum(sorted + start, bucket_len, &bucket_sums[b]);
+      }
+    }
+
+    void *running = NULL;
+    void *window_sum = NULL;
+    for (int b = num_buckets; success && b >= 1; b--) {
+      success = acc_add(ops, &running, bucket_sums[b]) && acc_add(ops, &window_sum, running);
+    }
+    for (int b = 1; b <= num_buckets; b++) {
+      if (bucket_sums[b] != NULL) {
+        ops->destroy(bucket_sums[b]);
+        bucket_sums[b] = NULL;
+      }
+    }
+    if (running != NULL) {
+      ops->destroy(running);
+    }
+
+    if (success && w != num_windows - 1) {
+      for (int i = 0; success && i < c; i++) {
+        success = acc_double(ops, &result);
+      }
+    }
+    success = success && acc_add(ops, &result, window_sum);
+    if (window_sum != NULL) {
+      ops->destroy(window_sum);
+    }
+  }
+
+  free(counts);
+  free(digits);
+  free(sorted);
+  free(bucket_sums);
+
+  /*
+   * The identity is not a valid public key or signature, so a zero result is reported as a
+   * failure, whether all scalars were zero or the weighted points cancelled out
+   */
+  bool identity = result == NULL;
+  if (success && !identity) {
+    success = is_identity(ops, result, points[0], &identity);
+  }
+  if (!success || identity) {
+    if (result != NULL) {
+      ops->destroy(result);
+    }
+    return false;
+  }
+  *out = result;
+  return true;
+}
+
+bool public_keys_msm(const PublicKey *const *in_public_keys,
+                     const uint8_t *in_scalars,
+                     int in_len,
+                     PublicKey **out_public_key) {
+  return msm(&public_key_ops, (const void *const *)in_public_keys, in_scalars, in_len, (void **)out_public_key);
+}
+
+bool signatures_msm(const Signature *const *in_signatures,
+                    const uint8_t *in_scalars,
+                    int in_len,
+                    Signature **out_signature) {
+  return msm(&signature_ops, (const void *const *)in_signatures, in_scalars, in_len, (void **)out_signature);
+}
@@ -0,0 +1,89 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"time"
+	"unsafe"
+)
+
+// packScalars copies the scalars, each a little-endian `PRIVATEKEYBYTES` long field element, into one buffer.
+func packScalars(scalars [][]byte) ([]byte, error) {
+	packed := make([]byte, len(scalars)*PRIVATEKEYBYTES)
+	for i, scalar := range scalars {
+		if len(scalar) != PRIVATEKEYBYTES {
+			return nil, IncorrectSizeError
+		}
+		copy(packed[i*PRIVATEKEYBYTES:], scalar)
+	}
+	return packed, nil
+}
+
+// PublicKeysMSM computes the weighted aggregate `sum(scalars[i] * publicKeys[i])` with a multi-scalar multiplication.
+// Each scalar is a little-endian `PRIVATEKEYBYTES` long field element, in the same format as a serialized private key.
+func PublicKeysMSM(publicKeys []*PublicKey, scalars [][]byte) (*PublicKey, error) {
+	if len(publicKeys) == 0 {
+		return nil, EmptySliceError
+	}
+	if len(publicKeys) != len(scalars) {
+		return nil, IncorrectSizeError
+	}
+
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(publicKeys))
+	for i, pk := range publicKeys {
+		if pk == nil {
+			return nil, NilPointerError
+		}
+		publicKeysPtrs[i] = pk.ptr
+	}
+	packedScalars, err := packScalars(scalars)
+	if err != nil {
+		return nil, err
+	}
+	scalarsPtr, _ := sliceToPtr(packedScalars)
+
+	publicKey := &PublicKey{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.public_keys_msm((**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])), scalarsPtr, C.int(len(publicKeysPtrs)), &publicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return publicKey, nil
+}
+
+// SignaturesMSM computes the weighted aggregate `sum(scalars[i] * signatures[i])` with a multi-scalar multiplication.
+// The scalars are in the same format as for PublicKeysMSM.
+func SignaturesMSM(signatures []*Signature, scalars [][]byte) (*Signature, error) {
+	if len(signatures) == 0 {
+		return nil, EmptySliceError
+	}
+	if len(signatures) != len(scalars) {
+		return nil, IncorrectSizeError
+	}
+
+	signaturesPtrs := make([]*C.struct_Signature, len(signatures))
+	for i, sig := range signatures {
+		if sig == nil {
+			return nil, NilPointerError
+		}
+		signaturesPtrs[i] = sig.ptr
+	}
+	packedScalars, err := packScalars(scalars)
+	if err != nil {
+		return nil, err
+	}
+	scalarsPtr, _ := sliceToPtr(packedScalars)
+
+	signature := &Signature{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.signatures_msm((**C.struct_Signature)(unsafe.Pointer(&signaturesPtrs[0])), scalarsPtr, C.int(len(signaturesPtrs)), &signature.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return signature, nil
+}
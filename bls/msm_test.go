@@ -0,0 +1,196 @@
+// +build windows
+
+package bls
+
+import (
+	"fmt"
+	"math/big"
+	"math/rand"
+	"testing"
+)
+
+// scalarOrder is the order of the BLS12-377 groups
+var scalarOrder, _ = new(big.Int).SetString("12ab655e9a2ca55660b44d1e5c37b00159aa76fed00000010a11800000000001", 16)
+
+func scalarBytes(scalar *big.Int) []byte {
+	bytes := make([]byte, PRIVATEKEYBYTES)
+	bigEndian := scalar.Bytes()
+	for i, b := range bigEndian {
+		bytes[len(bigEndian)-1-i] = b
+	}
+	return bytes
+}
+
+func scalarBit(scalar []byte, bit int) bool {
+	return (scalar[bit/8]>>(bit%8))&1 == 1
+}
+
+func repeatScalar(scalar int64, n int) [][]byte {
+	scalars := make([][]byte, n)
+	for i := range scalars {
+		scalars[i] = scalarBytes(big.NewInt(scalar))
+	}
+	return scalars
+}
+
+// randomScalars returns full 256-bit scalars, so that the top partial window of every window size is exercised
+func randomScalars(random *rand.Rand, n int) [][]byte {
+	scalars := make([][]byte, n)
+	for i := range scalars {
+		scalars[i] = make([]byte, PRIVATEKEYBYTES)
+		random.Read(scalars[i])
+		scalars[i][PRIVATEKEYBYTES-1] |= 0x80
+	}
+	return scalars
+}
+
+// publicKeysDoubleAndAdd computes `sum(scalars[i] * publicKeys[i])` by repeated aggregation, from the most significant bit.
+func publicKeysDoubleAndAdd(t *testing.T, publicKeys []*PublicKey, scalars [][]byte) *PublicKey {
+	var acc *PublicKey
+	for bit := 8*PRIVATEKEYBYTES - 1; bit >= 0; bit-- {
+		terms := []*PublicKey{}
+		if acc != nil {
+			terms = append(terms, acc, acc)
+		}
+		for i, scalar := range scalars {
+			if scalarBit(scalar, bit) {
+				terms = append(terms, publicKeys[i])
+			}
+		}
+		if len(terms) == 0 {
+			continue
+		}
+		next := aggregatePublicKeys(t, terms)
+		if acc != nil {
+			acc.Destroy()
+		}
+		acc = next
+	}
+	return acc
+}
+
+// signaturesDoubleAndAdd computes `sum(scalars[i] * signatures[i])` like publicKeysDoubleAndAdd.
+func signaturesDoubleAndAdd(t *testing.T, signatures []*Signature, scalars [][]byte) *Signature {
+	var acc *Signature
+	for bit := 8*PRIVATEKEYBYTES - 1; bit >= 0; bit-- {
+		terms := []*Signature{}
+		if acc != nil {
+			terms = append(terms, acc, acc)
+		}
+		for i, scalar := range scalars {
+			if scalarBit(scalar, bit) {
+				terms = append(terms, signatures[i])
+			}
+		}
+		if len(terms) == 0 {
+			continue
+		}
+		next := aggregateSignatures(t, terms)
+		if acc != nil {
+			acc.Destroy()
+		}
+		acc = next
+	}
+	return acc
+}
+
+type msmFixture struct {
+	signers    []signer
+	publicKeys []*PublicKey
+	signatures []*Signature
+}
+
+func newMSMFixture(t *testing.T, n int) *msmFixture {
+	fixture := &msmFixture{signers: newSigners(t, n)}
+	for i, signer := range fixture.signers {
+		fixture.publicKeys = append(fixture.publicKeys, signer.publicKey)
+		fixture.signatures = append(fixture.signatures, sign(t, signer.privateKey, []byte(fmt.Sprintf("message %d", i)), nil, false, false))
+	}
+	return fixture
+}
+
+func (self *msmFixture) destroy() {
+	for _, signature := range self.signatures {
+		signature.Destroy()
+	}
+	destroySigners(self.signers)
+}
+
+// requireMSM checks both multi-scalar multiplications against the expected public key and signature.
+func (self *msmFixture) requireMSM(t *testing.T, scalars [][]byte, expectedPublicKey *PublicKey, expectedSignature *Signature) {
+	t.Helper()
+
+	publicKey, err := PublicKeysMSM(self.publicKeys[:len(scalars)], scalars)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer publicKey.Destroy()
+	requireSamePublicKey(t, expectedPublicKey, publicKey)
+
+	signature, err := SignaturesMSM(self.signatures[:len(scalars)], scalars)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer signature.Destroy()
+	requireSameSignature(t, expectedSignature, signature)
+}
+
+func TestMSMUnitScalars(t *testing.T) {
+	fixture := newMSMFixture(t, 40)
+	defer fixture.destroy()
+
+	for _, n := range []int{1, 7, 40} {
+		expectedPublicKey := aggregatePublicKeys(t, fixture.publicKeys[:n])
+		expectedSignature := aggregateSignatures(t, fixture.signatures[:n])
+		fixture.requireMSM(t, repeatScalar(1, n), expectedPublicKey, expectedSignature)
+		expectedPublicKey.Destroy()
+		expectedSignature.Destroy()
+	}
+}
+
+func TestMSMDoubling(t *testing.T) {
+	fixture := newMSMFixture(t, 1)
+	defer fixture.destroy()
+
+	expectedPublicKey := aggregatePublicKeys(t, []*PublicKey{fixture.publicKeys[0], fixture.publicKeys[0]})
+	defer expectedPublicKey.Destroy()
+	expectedSignature := aggregateSignatures(t, []*Signature{fixture.signatures[0], fixture.signatures[0]})
+	defer expectedSignature.Destroy()
+	fixture.requireMSM(t, repeatScalar(2, 1), expectedPublicKey, expectedSignature)
+}
+
+func TestMSMRandomScalars(t *testing.T) {
+	fixture := newMSMFixture(t, 100)
+	defer fixture.destroy()
+	random := rand.New(rand.NewSource(1))
+
+	// 3-bit windows below 32 points and wider ones above, none of which divides the 256 scalar bits
+	for _, n := range []int{1, 7, 31, 32, 40, 100} {
+		t.Run(fmt.Sprint(n), func(t *testing.T) {
+			scalars := randomScalars(random, n)
+			expectedPublicKey := publicKeysDoubleAndAdd(t, fixture.publicKeys[:n], scalars)
+			defer expectedPublicKey.Destroy()
+			expectedSignature := signaturesDoubleAndAdd(t, fixture.signatures[:n], scalars)
+			defer expectedSignature.Destroy()
+			fixture.requireMSM(t, scalars, expectedPublicKey, expectedSignature)
+		})
+	}
+}
+
+func TestMSMIdentity(t *testing.T) {
+	fixture := newMSMFixture(t, 1)
+	defer fixture.destroy()
+
+	// p + (r - 1) * p is the identity, which is not a valid public key or signature
+	minusOne := scalarBytes(new(big.Int).Sub(scalarOrder, big.NewInt(1)))
+	scalars := [][]byte{scalarBytes(big.NewInt(1)), minusOne}
+	if _, err := PublicKeysMSM([]*PublicKey{fixture.publicKeys[0], fixture.publicKeys[0]}, scalars); err != GeneralError {
+		t.Errorf("expected the identity public key to be rejected, got %v", err)
+	}
+	if _, err := SignaturesMSM([]*Signature{fixture.signatures[0], fixture.signatures[0]}, scalars); err != GeneralError {
+		t.Errorf("expected the identity signature to be rejected, got %v", err)
+	}
+	if _, err := PublicKeysMSM(fixture.publicKeys, repeatScalar(0, 1)); err != GeneralError {
+		t.Errorf("expected a zero scalar to be rejected, got %v", err)
+	}
+}
@@ -0,0 +1,122 @@
+package bls
+
+import (
+	"runtime"
+	"sync"
+)
+
+// minChunkSize is the smallest number of elements handed to a single worker, so that small inputs
+// are processed in one cgo call instead of paying for goroutine scheduling.
+const minChunkSize = 16
+
+// workerPool is a persistent set of goroutines which run the chunks of parallel calls, so that
+// the number of OS threads blocked in cgo at the same time is bounded by its size.
+type workerPool struct {
+	size int
+	jobs chan func()
+	quit chan struct{}
+}
+
+var (
+	poolMutex sync.RWMutex
+	pool      = newWorkerPool(0)
+)
+
+func newWorkerPool(size int) *workerPool {
+	if size <= 0 {
+		size = runtime.GOMAXPROCS(0)
+	}
+	p := &workerPool{
+		size: size,
+		jobs: make(chan func()),
+		quit: make(chan struct{}),
+	}
+	for i := 0; i < size; i++ {
+		go func() {
+			for {
+				select {
+				case job := <-p.jobs:
+					job()
+				case <-p.quit:
+					return
+				}
+			}
+		}()
+	}
+
+	return p
+}
+
+// run hands job to an idle worker, or runs it on the calling goroutine if all workers are busy.
+// Running inline instead of queueing means nested parallel calls can never deadlock the pool.
+func (self *workerPool) run(job func()) {
+	select {
+	case self.jobs <- job:
+	default:
+		job()
+	}
+}
+
+// SetThreadPool sets the number of workers used by the parallel batch functions of this package.
+// A value of zero or less uses GOMAXPROCS workers. The workers are persistent, so calls do not pay
+// for spawning threads. Calls already in flight finish on the previous pool's remaining workers
+// or on their calling goroutine.
+func SetThreadPool(threads int) {
+	newPool := newWorkerPool(threads)
+
+	poolMutex.Lock()
+	oldPool := pool
+	pool = newPool
+	poolMutex.Unlock()
+
+	close(oldPool.quit)
+}
+
+// ThreadPoolSize returns the number of workers used by the parallel batch functions of this package.
+func ThreadPoolSize() int {
+	poolMutex.RLock()
+	defer poolMutex.RUnlock()
+	return pool.size
+}
+
+// parallelChunks splits [0, n) into contiguous chunks and calls fn on each of them concurrently.
+// Every chunk is meant to be processed by a single cgo call, which runs on its own OS thread.
+func parallelChunks(n int, fn func(start, end int)) {
+	parallelChunksWith(n, minChunkSize, 0, fn)
+}
+
+// parallelChunksWith is like parallelChunks with chunks of at least minChunk elements, handed to at
+// most maxWorkers workers of the pool. A maxWorkers of zero or less uses the whole pool.
+func parallelChunksWith(n, minChunk, maxWorkers int, fn func(start, end int)) {
+	poolMutex.RLock()
+	p := pool
+	poolMutex.RUnlock()
+
+	workers := p.size
+	if maxWorkers > 0 && workers > maxWorkers {
+		workers = maxWorkers
+	}
+	if max := (n + minChunk - 1) / minChunk; workers > max {
+		workers = max
+	}
+	if workers <= 1 {
+		fn(0, n)
+		return
+	}
+
+	chunkSize := (n + workers - 1) / workers
+	var wg sync.WaitGroup
+	for start := 0; start < n; start += chunkSize {
+		end := start + chunkSize
+		if end > n {
+			end = n
+		}
+		wg.Add(1)
+		start := start
+		p.run(func() {
+			defer wg.Done()
+			fn(start, end)
+		})
+	}
+	wg.Wait()
+}
@@ -0,0 +1,216 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"container/list"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+const (
+	pubkeyCacheShards = 32
+	// pubkeyCacheEntryBytes estimates the memory held by a cache entry: the serialized key plus a
+	// projective G2 point of three Fq2 coordinates.
+	pubkeyCacheEntryBytes = PUBLICKEYBYTES + 3*2*48
+)
+
+// PublicKeyCacheStats reports the activity of the public key cache used by DeserializePublicKeyCached.
+// Hits and misses only count lookups in the cache of this package, which are not made while it is disabled.
+type PublicKeyCacheStats struct {
+	Hits    uint64
+	Misses  uint64
+	Entries int
+	// Bytes is an estimate of the memory held by the cached entries.
+	Bytes int
+}
+
+type pubkeyCacheEntry struct {
+	key [PUBLICKEYBYTES]byte
+	ptr *C.struct_PublicKey
+}
+
+// pubkeyCacheShard is an LRU over a fraction of the keys, so that goroutines deserializing different keys
+// rarely contend on the same mutex.
+type pubkeyCacheShard struct {
+	mutex      sync.Mutex
+	maxEntries int
+	entries    map[[PUBLICKEYBYTES]byte]*list.Element
+	lru        *list.List
+}
+
+type pubkeyCache struct {
+	hits   uint64
+	misses uint64
+	// maxEntries is the limit across all shards, zero when this cache is disabled
+	maxEntries int64
+	shards     [pubkeyCacheShards]pubkeyCacheShard
+}
+
+var publicKeyCache = newPubkeyCache()
+
+func newPubkeyCache() *pubkeyCache {
+	cache := &pubkeyCache{}
+	for i := range cache.shards {
+		cache.shards[i].entries = make(map[[PUBLICKEYBYTES]byte]*list.Element)
+		cache.shards[i].lru = list.New()
+	}
+	return cache
+}
+
+func (self *pubkeyCache) shard(key *[PUBLICKEYBYTES]byte) *pubkeyCacheShard {
+	// The serialized key is a compressed curve point, so its low bytes are already uniformly distributed
+	return &self.shards[int(key[0])%pubkeyCacheShards]
+}
+
+// clonePublicKey returns a new handle to the same point, which is a single-element aggregation natively.
+func clonePublicKey(ptr *C.struct_PublicKey) (*PublicKey, error) {
+	publicKey := &PublicKey{}
+	success := C.aggregate_public_keys(&ptr, 1, &publicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+	return publicKey, nil
+}
+
+// get returns a new handle to the cached public key, or nil if it is not cached.
+func (self *pubkeyCacheShard) get(key *[PUBLICKEYBYTES]byte) (*PublicKey, error) {
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+
+	element, ok := self.entries[*key]
+	if !ok {
+		return nil, nil
+	}
+	self.lru.MoveToFront(element)
+	// The handle is cloned under the lock, so that it cannot be evicted and destroyed concurrently
+	return clonePublicKey(element.Value.(*pubkeyCacheEntry).ptr)
+}
+
+// put takes ownership of ptr, caching it under key and evicting the least recently used entries above the limit.
+func (self *pubkeyCacheShard) put(key *[PUBLICKEYBYTES]byte, ptr *C.struct_PublicKey) {
+	self.mutex.Lock()
+	defer self.mutex.Unlock()
+
+	if _, ok := self.entries[*key]; ok || self.maxEntries == 0 {
+		C.destroy_public_key(ptr)
+		return
+	}
+	self.entries[*key] = self.lru.PushFront(&pubkeyCacheEntry{key: *key, ptr: ptr})
+	self.evict()
+}
+
+// evict destroys the least recently used entries until the shard is within its limit. Must be called with the lock held.
+func (self *pubkeyCacheShard) evict() {
+	for self.lru.Len() > self.maxEntries {
+		entry := self.lru.Remove(self.lru.Back()).(*pubkeyCacheEntry)
+		delete(self.entries, entry.key)
+		C.destroy_public_key(entry.ptr)
+	}
+}
+
+func (self *pubkeyCache) deserialize(publicKeyBytes []byte) (*PublicKey, error) {
+	publicKeyPtr, publicKeyLen := sliceToPtr(publicKeyBytes)
+	if atomic.LoadInt64(&self.maxEntries) == 0 {
+		publicKey := &PublicKey{}
+		defer deserializeMetrics.Record(time.Now())
+		success := C.deserialize_public_key_cached(publicKeyPtr, publicKeyLen, &publicKey.ptr)
+		if !success {
+			return nil, GeneralError
+		}
+		return publicKey, nil
+	}
+
+	var key [PUBLICKEYBYTES]byte
+	copy(key[:], publicKeyBytes)
+	shard := self.shard(&key)
+
+	publicKey, err := shard.get(&key)
+	if err != nil {
+		return nil, err
+	}
+	if publicKey != nil {
+		atomic.AddUint64(&self.hits, 1)
+		return publicKey, nil
+	}
+	atomic.AddUint64(&self.misses, 1)
+
+	// The key is not handed to the library's own cache, which is unbounded, so that this cache is the only one
+	publicKey = &PublicKey{}
+	defer deserializeMetrics.Record(time.Now())
+	success := C.deserialize_public_key(publicKeyPtr, publicKeyLen, &publicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	shard.mutex.Lock()
+	enabled := shard.maxEntries > 0
+	shard.mutex.Unlock()
+	if enabled {
+		cached, err := clonePublicKey(publicKey.ptr)
+		if err == nil {
+			shard.put(&key, cached.ptr)
+		}
+	}
+
+	return publicKey, nil
+}
+
+// PublicKeyCacheConfigure bounds the number of public keys kept by DeserializePublicKeyCached, evicting the least
+// recently used keys above the limit. The limit is split across the shards of the cache, so that it is never
+// exceeded, and each key is only evicted by keys of its own shard.
+//
+// A limit of zero, the default, disables caching in this package and leaves it to the library's own unbounded
+// cache. Otherwise the library's cache is bypassed for the keys deserialized through this package.
+func PublicKeyCacheConfigure(maxEntries int) {
+	if maxEntries < 0 {
+		maxEntries = 0
+	}
+	atomic.StoreInt64(&publicKeyCache.maxEntries, int64(maxEntries))
+	for i := range publicKeyCache.shards {
+		shard := &publicKeyCache.shards[i]
+		shard.mutex.Lock()
+		shard.maxEntries = maxEntries / pubkeyCacheShards
+		if i < maxEntries%pubkeyCacheShards {
+			shard.maxEntries++
+		}
+		shard.evict()
+		shard.mutex.Unlock()
+	}
+}
+
+// GetPublicKeyCacheStats returns the hit and miss counts of DeserializePublicKeyCached and the size of the cache.
+func GetPublicKeyCacheStats() PublicKeyCacheStats {
+	stats := PublicKeyCacheStats{
+		Hits:   atomic.LoadUint64(&publicKeyCache.hits),
+		Misses: atomic.LoadUint64(&publicKeyCache.misses),
+	}
+	for i := range publicKeyCache.shards {
+		shard := &publicKeyCache.shards[i]
+		shard.mutex.Lock()
+		stats.Entries += shard.lru.Len()
+		shard.mutex.Unlock()
+	}
+	stats.Bytes = stats.Entries * pubkeyCacheEntryBytes
+
+	return stats
+}
+
+// PublicKeyCacheClear destroys all cached public keys and resets the statistics.
+func PublicKeyCacheClear() {
+	for i := range publicKeyCache.shards {
+		shard := &publicKeyCache.shards[i]
+		shard.mutex.Lock()
+		maxEntries := shard.maxEntries
+		shard.maxEntries = 0
+		shard.evict()
+		shard.maxEntries = maxEntries
+		shard.mutex.Unlock()
+	}
+	atomic.StoreUint64(&publicKeyCache.hits, 0)
+	atomic.StoreUint64(&publicKeyCache.misses, 0)
+}
@@ -0,0 +1,87 @@
+// +build windows
+
+package bls
+
+import (
+	"bytes"
+	"testing"
+)
+
+func resetPublicKeyCache() {
+	PublicKeyCacheConfigure(0)
+	PublicKeyCacheClear()
+}
+
+func TestPublicKeyCacheLimit(t *testing.T) {
+	signers := newSigners(t, 100)
+	defer destroySigners(signers)
+	defer resetPublicKeyCache()
+
+	for _, limit := range []int{1, 40, 64} {
+		resetPublicKeyCache()
+		PublicKeyCacheConfigure(limit)
+		for _, signer := range signers {
+			publicKey, err := DeserializePublicKeyCached(serializePublicKey(t, signer.publicKey))
+			if err != nil {
+				t.Fatal(err)
+			}
+			publicKey.Destroy()
+
+			if stats := GetPublicKeyCacheStats(); stats.Entries > limit {
+				t.Fatalf("limit %d: the cache holds %d entries", limit, stats.Entries)
+			}
+		}
+		if stats := GetPublicKeyCacheStats(); stats.Misses != uint64(len(signers)) || stats.Hits != 0 {
+			t.Errorf("limit %d: expected %d misses and no hits, got %+v", limit, len(signers), stats)
+		}
+	}
+}
+
+func TestPublicKeyCacheHits(t *testing.T) {
+	signers := newSigners(t, 1)
+	defer destroySigners(signers)
+	defer resetPublicKeyCache()
+	resetPublicKeyCache()
+	publicKeyBytes := serializePublicKey(t, signers[0].publicKey)
+
+	// The stats only cover this package's cache, which is disabled by default
+	publicKey, err := DeserializePublicKeyCached(publicKeyBytes)
+	if err != nil {
+		t.Fatal(err)
+	}
+	publicKey.Destroy()
+	if stats := GetPublicKeyCacheStats(); stats.Hits != 0 || stats.Misses != 0 || stats.Entries != 0 {
+		t.Errorf("expected a disabled cache to count nothing, got %+v", stats)
+	}
+
+	PublicKeyCacheConfigure(10)
+	first, err := DeserializePublicKeyCached(publicKeyBytes)
+	if err != nil {
+		t.Fatal(err)
+	}
+	hit, err := DeserializePublicKeyCached(publicKeyBytes)
+	if err != nil {
+		t.Fatal(err)
+	}
+	stats := GetPublicKeyCacheStats()
+	if stats.Misses != 1 || stats.Hits != 1 || stats.Entries != 1 {
+		t.Errorf("expected one miss, one hit and one entry, got %+v", stats)
+	}
+	if stats.Bytes != pubkeyCacheEntryBytes {
+		t.Errorf("expected %d bytes, got %d", pubkeyCacheEntryBytes, stats.Bytes)
+	}
+
+	// Handles returned by the cache are independent of the cached entry and of each other
+	first.Destroy()
+	requireSamePublicKey(t, signers[0].publicKey, hit)
+	hit.Destroy()
+	again, err := DeserializePublicKeyCached(publicKeyBytes)
+	if err != nil {
+		t.Fatal(err)
+	}
+	PublicKeyCacheClear()
+	if !bytes.Equal(serializePublicKey(t, again), publicKeyBytes) {
+		t.Error("a handle returned by the cache changed after the cache was cleared")
+	}
+	again.Destroy()
+}
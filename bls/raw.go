@@ -0,0 +1,77 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"time"
+	"unsafe"
+)
+
+// DeserializePublicKeyArray is like DeserializePublicKey for a key whose size is fixed by its type.
+func DeserializePublicKeyArray(publicKeyBytes *[PUBLICKEYBYTES]byte) (*PublicKey, error) {
+	if publicKeyBytes == nil {
+		return nil, NilPointerError
+	}
+
+	publicKey := &PublicKey{}
+	defer deserializeMetrics.Record(time.Now())
+	success := C.deserialize_public_key_96((*[C.BLS_PUBLIC_KEY_BYTES]C.uchar)(unsafe.Pointer(publicKeyBytes)), &publicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return publicKey, nil
+}
+
+// DeserializeSignatureArray is like DeserializeSignature for a signature whose size is fixed by its type.
+func DeserializeSignatureArray(signatureBytes *[SIGNATUREBYTES]byte) (*Signature, error) {
+	if signatureBytes == nil {
+		return nil, NilPointerError
+	}
+
+	signature := &Signature{}
+	defer deserializeMetrics.Record(time.Now())
+	success := C.deserialize_signature_48((*[C.BLS_SIGNATURE_BYTES]C.uchar)(unsafe.Pointer(signatureBytes)), &signature.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return signature, nil
+}
+
+// VerifySignatureRaw verifies a serialized signature against a serialized public key in a single cgo call,
+// without allocating handles which would have to be destroyed. It suits one-off verifications; keys which
+// verify many signatures are better deserialized once.
+func VerifySignatureRaw(publicKeyBytes *[PUBLICKEYBYTES]byte, message []byte, extraData []byte, signatureBytes *[SIGNATUREBYTES]byte, shouldUseCompositeHasher, shouldUseCIP22 bool) error {
+	if publicKeyBytes == nil || signatureBytes == nil {
+		return NilPointerError
+	}
+
+	var verified C.bool
+	messagePtr, messageLen := sliceToPtr(message)
+	extraDataPtr, extraDataLen := sliceToPtr(extraData)
+
+	defer verifyMetrics.Record(time.Now())
+	success := C.verify_signature_raw(
+		(*[C.BLS_PUBLIC_KEY_BYTES]C.uchar)(unsafe.Pointer(publicKeyBytes)),
+		messagePtr,
+		messageLen,
+		extraDataPtr,
+		extraDataLen,
+		(*[C.BLS_SIGNATURE_BYTES]C.uchar)(unsafe.Pointer(signatureBytes)),
+		C.bool(shouldUseCompositeHasher),
+		C.bool(shouldUseCIP22),
+		&verified,
+	)
+	if !success {
+		return GeneralError
+	}
+	if !verified {
+		return NotVerifiedError
+	}
+
+	return nil
+}
@@ -0,0 +1,91 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+// sameMessage is a message/extra data pair which is verified against many signers, such as a consensus
+// proposal which is signed by every validator.
+type sameMessage struct {
+	data  []byte
+	extra []byte
+
+	shouldUseCompositeHasher bool
+	shouldUseCIP22           bool
+}
+
+func (self *sameMessage) batch(publicKeys []*PublicKey, signatures []*Signature) *Batch {
+	return &Batch{
+		Data:    self.data,
+		Extra:   self.extra,
+		Pubkeys: publicKeys,
+		Sigs:    signatures,
+	}
+}
+
+// VerifySameMessage verifies each signature against the public key at the same index, over the same message/extra
+// data pair. The library hashes the message to the curve once per batch, so all pairs are verified as a single strict
+// batch which pays for a single hash-to-curve instead of one per signature. If the batch does not verify, it is
+// bisected to locate the invalid pairs. It returns a nil error if all signatures verified, otherwise the bool slice
+// contains the individual result of each pair.
+func VerifySameMessage(message []byte, extraData []byte, publicKeys []*PublicKey, signatures []*Signature, shouldUseCompositeHasher, shouldUseCIP22 bool) ([]bool, error) {
+	sameMessage := &sameMessage{
+		data:                     message,
+		extra:                    extraData,
+		shouldUseCompositeHasher: shouldUseCompositeHasher,
+		shouldUseCIP22:           shouldUseCIP22,
+	}
+	return sameMessage.verify(publicKeys, signatures)
+}
+
+func (self *sameMessage) verify(publicKeys []*PublicKey, signatures []*Signature) ([]bool, error) {
+	if len(publicKeys) == 0 {
+		return nil, EmptySliceError
+	}
+	if len(publicKeys) != len(signatures) {
+		return nil, IncorrectSizeError
+	}
+	for i := range publicKeys {
+		if publicKeys[i] == nil || signatures[i] == nil {
+			return nil, NilPointerError
+		}
+	}
+
+	cResults := make([]C.bool, 1)
+	if batchVerifyStrict([]*Batch{self.batch(publicKeys, signatures)}, self.shouldUseCompositeHasher, self.shouldUseCIP22, cResults) {
+		return nil, nil
+	}
+
+	results := make([]bool, len(publicKeys))
+	self.bisect(publicKeys, signatures, results)
+	return results, NotVerifiedError
+}
+
+// bisect locates the invalid pairs of a range which is known to not verify, verifying both of its halves in one call.
+func (self *sameMessage) bisect(publicKeys []*PublicKey, signatures []*Signature, results []bool) {
+	if len(publicKeys) == 1 {
+		results[0] = false
+		return
+	}
+
+	half := len(publicKeys) / 2
+	batches := []*Batch{
+		self.batch(publicKeys[:half], signatures[:half]),
+		self.batch(publicKeys[half:], signatures[half:]),
+	}
+	cResults := make([]C.bool, len(batches))
+	batchVerifyStrict(batches, self.shouldUseCompositeHasher, self.shouldUseCIP22, cResults)
+
+	bounds := [][2]int{{0, half}, {half, len(publicKeys)}}
+	for i, bound := range bounds {
+		start, end := bound[0], bound[1]
+		if cResults[i] {
+			for j := start; j < end; j++ {
+				results[j] = true
+			}
+			continue
+		}
+		self.bisect(publicKeys[start:end], signatures[start:end], results[start:end])
+	}
+}
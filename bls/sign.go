@@ -0,0 +1,127 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"time"
+	"unsafe"
+)
+
+// Message is a message to be signed, with the extra data signed alongside it.
+type Message struct {
+	Data  []byte
+	Extra []byte
+}
+
+// signMessagesToFFI copies the messages into a C allocated `SignMessageFFI` array, which must be freed by the caller.
+func signMessagesToFFI(messages []Message) unsafe.Pointer {
+	// NB: a Go slice of C.SignMessageFFI would be a Go pointer to Go pointers
+	size := int(unsafe.Sizeof(C.SignMessageFFI{}))
+	messagesPtr := C.malloc(C.size_t(size * len(messages)))
+	for i := range messages {
+		msg := (*C.SignMessageFFI)(unsafe.Pointer(uintptr(messagesPtr) + uintptr(size*i)))
+		*msg = C.SignMessageFFI{
+			data:  toBuffer(messages[i].Data),
+			extra: toBuffer(messages[i].Extra),
+		}
+	}
+	return messagesPtr
+}
+
+// collectSignatures wraps the signatures produced by parallel chunks, destroying them all if any chunk failed.
+func collectSignatures(signaturesPtrs []*C.struct_Signature, cResults []C.bool) ([]*Signature, error) {
+	failed := false
+	for _, result := range cResults {
+		failed = failed || !bool(result)
+	}
+	if failed {
+		for i, ptr := range signaturesPtrs {
+			if cResults[i] {
+				C.destroy_signature(ptr)
+			}
+		}
+		return nil, GeneralError
+	}
+
+	signatures := make([]*Signature, len(signaturesPtrs))
+	for i, ptr := range signaturesPtrs {
+		signatures[i] = &Signature{ptr: ptr}
+	}
+	return signatures, nil
+}
+
+// SignMessages signs all messages with the private key. The messages are hashed and signed in parallel
+// across the worker pool, each worker signing its share of the messages in one call.
+func (self *PrivateKey) SignMessages(messages []Message, shouldUseCompositeHasher, shouldUseCIP22 bool) ([]*Signature, error) {
+	if len(messages) == 0 {
+		return nil, EmptySliceError
+	}
+
+	messagesPtr := signMessagesToFFI(messages)
+	defer C.free(messagesPtr)
+	size := uintptr(unsafe.Sizeof(C.SignMessageFFI{}))
+
+	signaturesPtrs := make([]*C.struct_Signature, len(messages))
+	cResults := make([]C.bool, len(messages))
+	parallelChunksWith(len(messages), 1, 0, func(start, end int) {
+		defer signMetrics.Record(time.Now())
+		success := C.sign_messages_batch(
+			self.ptr,
+			(*C.SignMessageFFI)(unsafe.Pointer(uintptr(messagesPtr)+size*uintptr(start))),
+			C.int(end-start),
+			C.bool(shouldUseCompositeHasher),
+			C.bool(shouldUseCIP22),
+			&signaturesPtrs[start],
+		)
+		for i := start; i < end; i++ {
+			cResults[i] = success
+		}
+	})
+
+	return collectSignatures(signaturesPtrs, cResults)
+}
+
+// SignMessagesMulti signs message i with private key i, such as for a remote signer serving many keys.
+// Like SignMessages, the pairs are signed in parallel across the worker pool.
+func SignMessagesMulti(privateKeys []*PrivateKey, messages []Message, shouldUseCompositeHasher, shouldUseCIP22 bool) ([]*Signature, error) {
+	if len(messages) == 0 {
+		return nil, EmptySliceError
+	}
+	if len(privateKeys) != len(messages) {
+		return nil, IncorrectSizeError
+	}
+
+	privateKeysPtrs := make([]*C.struct_PrivateKey, len(privateKeys))
+	for i, privateKey := range privateKeys {
+		if privateKey == nil {
+			return nil, NilPointerError
+		}
+		privateKeysPtrs[i] = privateKey.ptr
+	}
+
+	messagesPtr := signMessagesToFFI(messages)
+	defer C.free(messagesPtr)
+	size := uintptr(unsafe.Sizeof(C.SignMessageFFI{}))
+
+	signaturesPtrs := make([]*C.struct_Signature, len(messages))
+	cResults := make([]C.bool, len(messages))
+	parallelChunksWith(len(messages), 1, 0, func(start, end int) {
+		defer signMetrics.Record(time.Now())
+		success := C.sign_messages_multi(
+			(**C.struct_PrivateKey)(unsafe.Pointer(&privateKeysPtrs[start])),
+			(*C.SignMessageFFI)(unsafe.Pointer(uintptr(messagesPtr)+size*uintptr(start))),
+			C.int(end-start),
+			C.bool(shouldUseCompositeHasher),
+			C.bool(shouldUseCIP22),
+			&signaturesPtrs[start],
+		)
+		for i := start; i < end; i++ {
+			cResults[i] = success
+		}
+	})
+
+	return collectSignatures(signaturesPtrs, cResults)
+}
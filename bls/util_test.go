@@ -0,0 +1,156 @@
+// +build windows
+
+package bls
+
+import (
+	"bytes"
+	"testing"
+	"time"
+)
+
+type signer struct {
+	privateKey *PrivateKey
+	publicKey  *PublicKey
+}
+
+func newSigners(tb testing.TB, n int) []signer {
+	InitBLSCrypto()
+
+	signers := make([]signer, n)
+	for i := range signers {
+		privateKey, err := GeneratePrivateKey()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		publicKey, err := privateKey.ToPublic()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		signers[i] = signer{privateKey: privateKey, publicKey: publicKey}
+	}
+	return signers
+}
+
+func destroySigners(signers []signer) {
+	for _, signer := range signers {
+		signer.publicKey.Destroy()
+		signer.privateKey.Destroy()
+	}
+}
+
+func sign(tb testing.TB, privateKey *PrivateKey, message []byte, extraData []byte, shouldUseCompositeHasher, shouldUseCIP22 bool) *Signature {
+	signature, err := privateKey.SignMessage(message, extraData, shouldUseCompositeHasher, shouldUseCIP22)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return signature
+}
+
+func serializePublicKey(tb testing.TB, publicKey *PublicKey) []byte {
+	publicKeyBytes, err := publicKey.Serialize()
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return publicKeyBytes
+}
+
+// requireSamePublicKey fails if the public keys are not the same point.
+func requireSamePublicKey(tb testing.TB, expected, actual *PublicKey) {
+	tb.Helper()
+	if !bytes.Equal(serializePublicKey(tb, expected), serializePublicKey(tb, actual)) {
+		tb.Fatal("public keys differ")
+	}
+}
+
+func serializeSignature(tb testing.TB, signature *Signature) []byte {
+	signatureBytes, err := signature.Serialize()
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return signatureBytes
+}
+
+// requireSameSignature fails if the signatures are not the same point.
+func requireSameSignature(tb testing.TB, expected, actual *Signature) {
+	tb.Helper()
+	if !bytes.Equal(serializeSignature(tb, expected), serializeSignature(tb, actual)) {
+		tb.Fatal("signatures differ")
+	}
+}
+
+func aggregatePublicKeys(tb testing.TB, publicKeys []*PublicKey) *PublicKey {
+	aggregatedPublicKey, err := AggregatePublicKeys(publicKeys)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return aggregatedPublicKey
+}
+
+func aggregateSignatures(tb testing.TB, signatures []*Signature) *Signature {
+	aggregatedSignature, err := AggregateSignatures(signatures)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return aggregatedSignature
+}
+
+// receiveOnce waits for the result of a job and checks that no second result is delivered.
+func receiveOnce(tb testing.TB, result <-chan error) error {
+	tb.Helper()
+
+	var err error
+	select {
+	case err = <-result:
+	case <-time.After(30 * time.Second):
+		tb.Fatal("timed out waiting for a result")
+	}
+	select {
+	case extra := <-result:
+		tb.Fatalf("a second result was delivered: %v", extra)
+	default:
+	}
+	return err
+}
+
+// vote is a signature over a message, which is bad if it was signed over another message.
+type vote struct {
+	message   []byte
+	publicKey *PublicKey
+	signature *Signature
+	bad       bool
+}
+
+// newVotes signs the messages with a signer each. The votes at the bad indices are signed over another message.
+func newVotes(tb testing.TB, signers []signer, messages [][]byte, bad map[int]bool, shouldUseCompositeHasher, shouldUseCIP22 bool) []vote {
+	votes := make([]vote, len(messages))
+	for i, message := range messages {
+		signedMessage := message
+		if bad[i] {
+			signedMessage = []byte("another message")
+		}
+		votes[i] = vote{
+			message:   message,
+			publicKey: signers[i].publicKey,
+			signature: sign(tb, signers[i].privateKey, signedMessage, nil, shouldUseCompositeHasher, shouldUseCIP22),
+			bad:       bad[i],
+		}
+	}
+	return votes
+}
+
+func destroyVotes(votes []vote) {
+	for _, vote := range votes {
+		vote.signature.Destroy()
+	}
+}
+
+// requireVoteResult checks that a good vote verified and a bad one did not.
+func requireVoteResult(tb testing.TB, i int, vote vote, err error) {
+	tb.Helper()
+	if vote.bad && err != NotVerifiedError {
+		tb.Errorf("vote %d: expected NotVerifiedError, got %v", i, err)
+	}
+	if !vote.bad && err != nil {
+		tb.Errorf("vote %d: expected to verify, got %v", i, err)
+	}
+}
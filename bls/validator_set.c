@@ -0,0 +1,198 @@
+#include "bls_ext.h"
+
+#include <string.h>
+
+struct ValidatorSet {
+  PublicKey **public_keys;
+  int len;
+  int cap;
+  /* Aggregate of all public keys, NULL if the set is empty */
+  PublicKey *aggregate;
+};
+
+static bool validator_set_reserve(ValidatorSet *validator_set, int cap) {
+  if (cap <= validator_set->cap) {
+    return true;
+  }
+  int new_cap = validator_set->cap > 0 ? validator_set->cap : 16;
+  while (new_cap < cap) {
+    new_cap *= 2;
+  }
+  PublicKey **public_keys = realloc(validator_set->public_keys, (size_t)new_cap * sizeof(PublicKey *));
+  if (public_keys == NULL) {
+    return false;
+  }
+  validator_set->public_keys = public_keys;
+  validator_set->cap = new_cap;
+  return true;
+}
+
+bool validator_set_create(PublicKey *const *in_public_keys,
+                          int in_public_keys_len,
+                          ValidatorSet **out_validator_set) {
+  if (in_public_keys_len < 0) {
+    return false;
+  }
+  ValidatorSet *validator_set = calloc(1, sizeof(ValidatorSet));
+  if (validator_set == NULL) {
+    return false;
+  }
+  if (!validator_set_reserve(validator_set, in_public_keys_len)) {
+    free(validator_set);
+    return false;
+  }
+  if (in_public_keys_len > 0) {
+    if (!aggregate_public_keys((const PublicKey *const *)in_public_keys, in_public_keys_len, &validator_set->aggregate)) {
+      free(validator_set->public_keys);
+      free(validator_set);
+      return false;
+    }
+    memcpy(validator_set->public_keys, in_public_keys, (size_t)in_public_keys_len * sizeof(PublicKey *));
+  }
+  validator_set->len = in_public_keys_len;
+  *out_validator_set = validator_set;
+  return true;
+}
+
+bool validator_set_add(ValidatorSet *validator_set,
+                       const uint8_t *in_public_key_bytes,
+                       int in_public_key_bytes_len) {
+  if (!validator_set_reserve(validator_set, validator_set->len + 1)) {
+    return false;
+  }
+  PublicKey *public_key = NULL;
+  if (!deserialize_public_key(in_public_key_bytes, in_public_key_bytes_len, &public_key)) {
+    return false;
+  }
+
+  PublicKey *aggregate = NULL;
+  bool success;
+  if (validator_set->aggregate == NULL) {
+    success = aggregate_public_keys((const PublicKey *const *)&public_key, 1, &aggregate);
+  } else {
+    const PublicKey *pair[2] = {validator_set->aggregate, public_key};
+    success = aggregate_public_keys(pair, 2, &aggregate);
+  }
+  if (!success) {
+    destroy_public_key(public_key);
+    return false;
+  }
+
+  if (validator_set->aggregate != NULL) {
+    destroy_public_key(validator_set->aggregate);
+  }
+  validator_set->aggregate = aggregate;
+  validator_set->public_keys[validator_set->len++] = public_key;
+  return true;
+}
+
+bool validator_set_remove(ValidatorSet *validator_set, int index) {
+  if (index < 0 || index >= validator_set->len) {
+    return false;
+  }
+  PublicKey *public_key = validator_set->public_keys[index];
+
+  PublicKey *aggregate = NULL;
+  if (validator_set->len > 1 &&
+      !aggregate_public_keys_subtract(validator_set->aggregate, (const PublicKey *const *)&public_key, 1, &aggregate)) {
+    return false;
+  }
+  destroy_public_key(validator_set->aggregate);
+  validator_set->aggregate = aggregate;
+
+  destroy_public_key(public_key);
+  memmove(&validator_set->public_keys[index], &validator_set->public_keys[index + 1],
+          (size_t)(validator_set->len - index - 1) * sizeof(PublicKey *));
+  validator_set->len--;
+  return true;
+}
+
+bool validator_set_len(const ValidatorSet *validator_set, int *out_len) {
+  *out_len = validator_set->len;
+  return true;
+}
+
+bool validator_set_aggregate_signers(const ValidatorSet *validator_set,
+                                     const uint8_t *in_bitmap,
+                                     int in_bitmap_len,
+                                     PublicKey **out_public_key) {
+  int len = validator_set->len;
+  int signers_len = 0;
+  for (int i = 0; i < len; i++) {
+    if (i / 8 < in_bitmap_len && (in_bitmap[i / 8] >> (i % 8)) & 1) {
+      signers_len++;
+    }
+  }
+  if (signers_len == 0) {
+    return false;
+  }
+  if (signers_len == len) {
+    return aggregate_public_keys((const PublicKey *const *)&validator_set->aggregate, 1, out_public_key);
+  }
+
+  /* Collect whichever of the signers or the non-signers is the smaller group */
+  bool use_signers = signers_len <= len - signers_len;
+  int selected_len = use_signers ? signers_len : len - signers_len;
+  const PublicKey **selected = malloc((size_t)selected_len * sizeof(PublicKey *));
+  if (selected == NULL) {
+    return false;
+  }
+  int j = 0;
+  for (int i = 0; i < len; i++) {
+    bool signed_bit = i / 8 < in_bitmap_len && (in_bitmap[i / 8] >> (i % 8)) & 1;
+    if (signed_bit == use_signers) {
+      selected[j++] = validator_set->public_keys[i];
+    }
+  }
+
+  bool success;
+  if (use_signers) {
+    success = aggregate_public_keys(selected, selected_len, out_public_key);
+  } else {
+    success = aggregate_public_keys_subtract(validator_set->aggregate, selected, selected_len, out_public_key);
+  }
+  free(selected);
+  return success;
+}
+
+bool destroy_validator_set(ValidatorSet *validator_set) {
+  bool success = true;
+  for (int i = 0; i < validator_set->len; i++) {
+    success = destroy_public_key(validator_set->public_keys[i]) && success;
+  }
+  if (validator_set->aggregate != NULL) {
+    success = destroy_public_key(validator_set->aggregate) && success;
+  }
+  free(validator_set->public_keys);
+  free(validator_set);
+  return success;
+}
+
+bool verify_aggregated_seal(const ValidatorSet *validator_set,
+                            const uint8_t *in_bitmap,
+                            int in_bitmap_len,
+                            const uint8_t *in_message,
+                            int in_message_len,
+                            const uint8_t *in_extra_data,
+                            int in_extra_data_len,
+                            const uint8_t *in_signature_bytes,
+                            int in_signature_bytes_len,
+                            bool should_use_composite,
+                            bool should_use_cip22,
+                            bool *out_verified) {
+  Signature *signature = NULL;
+  if (!deserialize_signature(in_signature_bytes, in_signature_bytes_len, &signature)) {
+    return false;
+  }
+  PublicKey *public_key = NULL;
+  if (!validator_set_aggregate_signers(validator_set, in_bitmap, in_bitmap_len, &public_key)) {
+    destroy_signature(signature);
+    return false;
+  }
+
+  bool success = verify_signature(public_key, in_message, in_message_len, in_extra_data, in_extra_data_len,
+                                  signature, should_use_composite, should_use_cip22, out_verified);
+  destroy_public_key(public_key);
+  destroy_signature(signature);
+  return success;
+}
@@ -0,0 +1,167 @@
+package bls
+
+/*
+#include "bls_ext.h"
+*/
+import "C"
+
+import (
+	"math/big"
+	"time"
+	"unsafe"
+)
+
+// ValidatorSet holds the public keys of an epoch's validators natively, together with their cached aggregate.
+// It is created once per epoch and computes the aggregate public key of the signers of a block without
+// rebuilding the key list. It may be read concurrently, but Add and Remove must not race with other calls.
+type ValidatorSet struct {
+	ptr *C.struct_ValidatorSet
+}
+
+// NewValidatorSet creates a validator set from a contiguous buffer of serialized public keys, each `PUBLICKEYBYTES` long.
+func NewValidatorSet(publicKeysBytes []byte) (*ValidatorSet, error) {
+	publicKeys, errs, err := DeserializePublicKeys(publicKeysBytes)
+	if err != nil {
+		return nil, err
+	}
+	if errs != nil {
+		for _, pk := range publicKeys {
+			if pk != nil {
+				pk.Destroy()
+			}
+		}
+		for _, err := range errs {
+			if err != nil {
+				return nil, err
+			}
+		}
+	}
+
+	publicKeysPtrs := make([]*C.struct_PublicKey, len(publicKeys))
+	for i, pk := range publicKeys {
+		publicKeysPtrs[i] = pk.ptr
+	}
+
+	validatorSet := &ValidatorSet{}
+	success := C.validator_set_create((**C.struct_PublicKey)(unsafe.Pointer(&publicKeysPtrs[0])), C.int(len(publicKeysPtrs)), &validatorSet.ptr)
+	if !success {
+		for _, pk := range publicKeys {
+			pk.Destroy()
+		}
+		return nil, GeneralError
+	}
+
+	return validatorSet, nil
+}
+
+// Len returns the number of validators in the set.
+func (self *ValidatorSet) Len() int {
+	var length C.int
+	C.validator_set_len(self.ptr, &length)
+	return int(length)
+}
+
+// Add appends a serialized public key to the set, updating the cached aggregate with a single point addition.
+func (self *ValidatorSet) Add(publicKeyBytes []byte) error {
+	err := validatePublicKey(publicKeyBytes)
+	if err != nil {
+		return err
+	}
+
+	publicKeyPtr, publicKeyLen := sliceToPtr(publicKeyBytes)
+	defer deserializeMetrics.Record(time.Now())
+	success := C.validator_set_add(self.ptr, publicKeyPtr, publicKeyLen)
+	if !success {
+		return GeneralError
+	}
+
+	return nil
+}
+
+// Remove removes the public key at index from the set, shifting down the indices of the validators after it.
+func (self *ValidatorSet) Remove(index int) error {
+	success := C.validator_set_remove(self.ptr, C.int(index))
+	if !success {
+		return GeneralError
+	}
+
+	return nil
+}
+
+// AggregateSigners returns the aggregate public key of the validators whose bit is set in the bitmap,
+// using at most min(signers, non-signers) point additions.
+func (self *ValidatorSet) AggregateSigners(bitmap *big.Int) (*PublicKey, error) {
+	if bitmap == nil {
+		return nil, NilPointerError
+	}
+
+	bitmapBytes := bitmapToBytes(bitmap)
+	bitmapPtr, bitmapLen := sliceToPtr(bitmapBytes)
+
+	aggregatedPublicKey := &PublicKey{}
+	defer aggregateMetrics.Record(time.Now())
+	success := C.validator_set_aggregate_signers(self.ptr, bitmapPtr, bitmapLen, &aggregatedPublicKey.ptr)
+	if !success {
+		return nil, GeneralError
+	}
+
+	return aggregatedPublicKey, nil
+}
+
+// VerifyAggregatedSeal verifies the aggregated signature of the validators in the bitmap over the message/extra data pair.
+// The aggregation, signature deserialization and verification happen in a single cgo call.
+func (self *ValidatorSet) VerifyAggregatedSeal(bitmap *big.Int, message []byte, extraData []byte, signatureBytes []byte, shouldUseCompositeHasher, shouldUseCIP22 bool) error {
+	var verified C.bool
+
+	if bitmap == nil {
+		return NilPointerError
+	}
+	err := validateSignature(signatureBytes)
+	if err != nil {
+		return err
+	}
+
+	bitmapPtr, bitmapLen := sliceToPtr(bitmapToBytes(bitmap))
+	messagePtr, messageLen := sliceToPtr(message)
+	extraDataPtr, extraDataLen := sliceToPtr(extraData)
+	signaturePtr, signatureLen := sliceToPtr(signatureBytes)
+
+	defer verifyMetrics.Record(time.Now())
+	success := C.verify_aggregated_seal(
+		self.ptr,
+		bitmapPtr,
+		bitmapLen,
+		messagePtr,
+		messageLen,
+		extraDataPtr,
+		extraDataLen,
+		signaturePtr,
+		signatureLen,
+		C.bool(shouldUseCompositeHasher),
+		C.bool(shouldUseCIP22),
+		&verified,
+	)
+	if !success {
+		return GeneralError
+	}
+	if !verified {
+		return NotVerifiedError
+	}
+
+	return nil
+}
+
+func (self *ValidatorSet) Destroy() bool {
+	return bool(C.destroy_validator_set(self.ptr))
+}
+
+// bitmapToBytes converts a signer bitmap to the little-endian byte layout expected natively,
+// where bit `i % 8` of byte `i / 8` is set if validator `i` signed.
+func bitmapToBytes(bitmap *big.Int) []byte {
+	bytes := bitmap.Bytes()
+	for i, j := 0, len(bytes)-1; i < j; i, j = i+1, j-1 {
+		bytes[i], bytes[j] = bytes[j], bytes[i]
+	}
+
+	return bytes
+}
@@ -0,0 +1,156 @@
+// +build windows
+
+package bls
+
+import (
+	"math/big"
+	"testing"
+)
+
+// validatorSetFixture mirrors the keys of a ValidatorSet, so that its aggregates can be checked with AggregatePublicKeys.
+type validatorSetFixture struct {
+	signers      []signer
+	set          *ValidatorSet
+	validatorSet []signer
+}
+
+func newValidatorSetFixture(t *testing.T, n int) *validatorSetFixture {
+	signers := newSigners(t, n)
+	publicKeysBytes := []byte{}
+	for _, signer := range signers {
+		publicKeysBytes = append(publicKeysBytes, serializePublicKey(t, signer.publicKey)...)
+	}
+	set, err := NewValidatorSet(publicKeysBytes)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	return &validatorSetFixture{
+		signers:      signers,
+		set:          set,
+		validatorSet: append([]signer{}, signers...),
+	}
+}
+
+func (self *validatorSetFixture) destroy() {
+	self.set.Destroy()
+	destroySigners(self.signers)
+}
+
+func bitmapOf(indices ...int) *big.Int {
+	bitmap := new(big.Int)
+	for _, index := range indices {
+		bitmap.SetBit(bitmap, index, 1)
+	}
+	return bitmap
+}
+
+// requireAggregate checks the aggregate of the signers in the bitmap against AggregatePublicKeys over the signers.
+func (self *validatorSetFixture) requireAggregate(t *testing.T, bitmap *big.Int) {
+	t.Helper()
+
+	publicKeys := []*PublicKey{}
+	for i, signer := range self.validatorSet {
+		if bitmap.Bit(i) == 1 {
+			publicKeys = append(publicKeys, signer.publicKey)
+		}
+	}
+	expected := aggregatePublicKeys(t, publicKeys)
+	defer expected.Destroy()
+
+	actual, err := self.set.AggregateSigners(bitmap)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer actual.Destroy()
+	requireSamePublicKey(t, expected, actual)
+}
+
+func TestValidatorSetAggregateSigners(t *testing.T) {
+	fixture := newValidatorSetFixture(t, 20)
+	defer fixture.destroy()
+
+	if fixture.set.Len() != 20 {
+		t.Fatalf("expected 20 validators, got %d", fixture.set.Len())
+	}
+
+	// Few signers are summed, while almost all signers are found by subtracting the non-signers
+	fixture.requireAggregate(t, bitmapOf(1, 7, 12))
+	almostAll := []int{}
+	for i := 0; i < 20; i++ {
+		if i != 4 && i != 15 {
+			almostAll = append(almostAll, i)
+		}
+	}
+	fixture.requireAggregate(t, bitmapOf(almostAll...))
+	fixture.requireAggregate(t, bitmapOf(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19))
+
+	// Bits past the end of the set are ignored
+	fixture.requireAggregate(t, bitmapOf(3, 8))
+	actual, err := fixture.set.AggregateSigners(bitmapOf(3, 8, 20, 23, 64))
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer actual.Destroy()
+	expected := aggregatePublicKeys(t, []*PublicKey{fixture.validatorSet[3].publicKey, fixture.validatorSet[8].publicKey})
+	defer expected.Destroy()
+	requireSamePublicKey(t, expected, actual)
+}
+
+func TestValidatorSetAddRemove(t *testing.T) {
+	fixture := newValidatorSetFixture(t, 10)
+	defer fixture.destroy()
+
+	added := newSigners(t, 1)
+	defer destroySigners(added)
+	if err := fixture.set.Add(serializePublicKey(t, added[0].publicKey)); err != nil {
+		t.Fatal(err)
+	}
+	fixture.validatorSet = append(fixture.validatorSet, added[0])
+
+	if err := fixture.set.Remove(2); err != nil {
+		t.Fatal(err)
+	}
+	fixture.validatorSet = append(fixture.validatorSet[:2], fixture.validatorSet[3:]...)
+
+	if fixture.set.Len() != 10 {
+		t.Fatalf("expected 10 validators, got %d", fixture.set.Len())
+	}
+	fixture.requireAggregate(t, bitmapOf(2, 9))
+	fixture.requireAggregate(t, bitmapOf(0, 1, 2, 3, 4, 5, 6, 8, 9))
+	if err := fixture.set.Remove(10); err == nil {
+		t.Error("expected removing an index past the end to fail")
+	}
+}
+
+func TestValidatorSetVerifyAggregatedSeal(t *testing.T) {
+	fixture := newValidatorSetFixture(t, 10)
+	defer fixture.destroy()
+
+	message := []byte("block hash")
+	extraData := []byte("round")
+	signerIndices := []int{0, 2, 3, 5, 6, 7, 9}
+	signatures := []*Signature{}
+	for _, index := range signerIndices {
+		signatures = append(signatures, sign(t, fixture.validatorSet[index].privateKey, message, extraData, true, true))
+	}
+	defer func() {
+		for _, signature := range signatures {
+			signature.Destroy()
+		}
+	}()
+	seal := aggregateSignatures(t, signatures)
+	defer seal.Destroy()
+	sealBytes := serializeSignature(t, seal)
+
+	bitmap := bitmapOf(signerIndices...)
+	if err := fixture.set.VerifyAggregatedSeal(bitmap, message, extraData, sealBytes, true, true); err != nil {
+		t.Fatalf("expected the seal to verify, got %v", err)
+	}
+	if err := fixture.set.VerifyAggregatedSeal(bitmap, []byte("other block hash"), extraData, sealBytes, true, true); err != NotVerifiedError {
+		t.Fatalf("expected a seal over another message to not verify, got %v", err)
+	}
+	if err := fixture.set.VerifyAggregatedSeal(bitmapOf(0, 2, 3), message, extraData, sealBytes, true, true); err != NotVerifiedError {
+		t.Fatalf("expected a seal with a wrong bitmap to not verify, got %v", err)
+	}
+}
@@ -0,0 +1,131 @@
+package bls
+
+import (
+	"sync"
+	"time"
+)
+
+// voteBucket holds the votes over one message which have not been verified yet.
+type voteBucket struct {
+	message    *sameMessage
+	publicKeys []*PublicKey
+	signatures []*Signature
+	results    []chan error
+	timer      *time.Timer
+}
+
+// VoteAccumulator coalesces consensus votes which arrive one by one for the same message/extra data pair, and
+// verifies them as a single strict batch: one hash-to-curve for all votes instead of one per vote.
+// The votes over a message are flushed once flushCount of them are pending, or flushDelay after the first of them
+// arrived, whichever comes first. Invalid votes are located by bisecting the batch.
+type VoteAccumulator struct {
+	shouldUseCompositeHasher bool
+	shouldUseCIP22           bool
+	flushCount               int
+	flushDelay               time.Duration
+
+	mutex   sync.Mutex
+	buckets map[voteKey]*voteBucket
+}
+
+// NewVoteAccumulator creates a VoteAccumulator for votes hashed with the given hasher, flushing the votes over a
+// message when flushCount are pending (such as 2f+1) or flushDelay after the first one arrived.
+func NewVoteAccumulator(shouldUseCompositeHasher, shouldUseCIP22 bool, flushCount int, flushDelay time.Duration) *VoteAccumulator {
+	if flushCount <= 0 {
+		flushCount = 1
+	}
+
+	return &VoteAccumulator{
+		shouldUseCompositeHasher: shouldUseCompositeHasher,
+		shouldUseCIP22:           shouldUseCIP22,
+		flushCount:               flushCount,
+		flushDelay:               flushDelay,
+		buckets:                  make(map[voteKey]*voteBucket),
+	}
+}
+
+type voteKey struct {
+	data  string
+	extra string
+}
+
+// Add queues a vote over the message/extra data pair and returns a channel which receives its result once the
+// votes over the message are flushed: nil if the signature verified, NotVerifiedError if it did not, or another error.
+// The message and extra data are copied, so the caller may reuse their buffers once Add returns.
+func (self *VoteAccumulator) Add(message []byte, extraData []byte, publicKey *PublicKey, signature *Signature) <-chan error {
+	result := make(chan error, 1)
+	if publicKey == nil || signature == nil {
+		result <- NilPointerError
+		return result
+	}
+
+	key := voteKey{data: string(message), extra: string(extraData)}
+
+	self.mutex.Lock()
+	bucket, ok := self.buckets[key]
+	if !ok {
+		bucket = &voteBucket{message: &sameMessage{
+			data:                     append([]byte(nil), message...),
+			extra:                    append([]byte(nil), extraData...),
+			shouldUseCompositeHasher: self.shouldUseCompositeHasher,
+			shouldUseCIP22:           self.shouldUseCIP22,
+		}}
+		self.buckets[key] = bucket
+		bucket.timer = time.AfterFunc(self.flushDelay, func() {
+			self.flush(key, bucket)
+		})
+	}
+	bucket.publicKeys = append(bucket.publicKeys, publicKey)
+	bucket.signatures = append(bucket.signatures, signature)
+	bucket.results = append(bucket.results, result)
+	full := len(bucket.publicKeys) >= self.flushCount
+	self.mutex.Unlock()
+
+	// The vote which fills the bucket must not block its caller through the batch verification
+	if full {
+		go self.flush(key, bucket)
+	}
+
+	return result
+}
+
+// Flush verifies all pending votes immediately.
+func (self *VoteAccumulator) Flush() {
+	self.mutex.Lock()
+	buckets := self.buckets
+	self.buckets = make(map[voteKey]*voteBucket)
+	self.mutex.Unlock()
+
+	for _, bucket := range buckets {
+		bucket.timer.Stop()
+		bucket.verify()
+	}
+}
+
+// flush verifies the votes of the bucket, unless they were already flushed.
+func (self *VoteAccumulator) flush(key voteKey, bucket *voteBucket) {
+	self.mutex.Lock()
+	if self.buckets[key] != bucket {
+		self.mutex.Unlock()
+		return
+	}
+	delete(self.buckets, key)
+	self.mutex.Unlock()
+
+	bucket.timer.Stop()
+	bucket.verify()
+}
+
+func (self *voteBucket) verify() {
+	results, err := self.message.verify(self.publicKeys, self.signatures)
+	for i, result := range self.results {
+		switch {
+		case err == nil:
+			result <- nil
+		case err == NotVerifiedError && results[i]:
+			result <- nil
+		default:
+			result <- err
+		}
+	}
+}
@@ -0,0 +1,82 @@
+// +build windows
+
+package bls
+
+import (
+	"fmt"
+	"testing"
+	"time"
+)
+
+func addVotes(accumulator *VoteAccumulator, votes []vote) []<-chan error {
+	results := make([]<-chan error, len(votes))
+	for i, vote := range votes {
+		results[i] = accumulator.Add(vote.message, nil, vote.publicKey, vote.signature)
+	}
+	return results
+}
+
+func requireVoteResults(t *testing.T, votes []vote, results []<-chan error) {
+	for i, vote := range votes {
+		requireVoteResult(t, i, vote, receiveOnce(t, results[i]))
+	}
+}
+
+func TestVoteAccumulatorCountFlush(t *testing.T) {
+	signers := newSigners(t, 10)
+	defer destroySigners(signers)
+
+	for _, bad := range []map[int]bool{{}, {0: true}, {3: true}, {2: true, 7: true}} {
+		t.Run(fmt.Sprint(bad), func(t *testing.T) {
+			votes := newVotes(t, signers, sharedMessages(len(signers)), bad, true, true)
+			defer destroyVotes(votes)
+
+			// Only the shared message reaches the flush count; the timer must not fire during the test
+			accumulator := NewVoteAccumulator(true, true, len(signers)/2, time.Hour)
+			defer accumulator.Flush()
+			results := addVotes(accumulator, votes)
+
+			shared := len(signers) / 2
+			requireVoteResults(t, votes[:shared], results[:shared])
+			for i := shared; i < len(votes); i++ {
+				if len(results[i]) != 0 {
+					t.Errorf("vote %d: verified before its flush", i)
+				}
+			}
+
+			accumulator.Flush()
+			requireVoteResults(t, votes[shared:], results[shared:])
+		})
+	}
+}
+
+func TestVoteAccumulatorTimerFlush(t *testing.T) {
+	signers := newSigners(t, 8)
+	defer destroySigners(signers)
+	votes := newVotes(t, signers, sharedMessages(len(signers)), map[int]bool{1: true, 6: true}, false, false)
+	defer destroyVotes(votes)
+
+	accumulator := NewVoteAccumulator(false, false, 100, 10*time.Millisecond)
+	requireVoteResults(t, votes, addVotes(accumulator, votes))
+}
+
+func TestVoteAccumulatorReusedBuffer(t *testing.T) {
+	signers := newSigners(t, 4)
+	defer destroySigners(signers)
+	message := []byte("proposal")
+	bad := map[int]bool{2: true}
+	votes := newVotes(t, signers, [][]byte{message, message, message, message}, bad, true, true)
+	defer destroyVotes(votes)
+
+	accumulator := NewVoteAccumulator(true, true, 100, time.Hour)
+	buffer := make([]byte, len(message))
+	results := make([]<-chan error, len(votes))
+	for i, vote := range votes {
+		copy(buffer, vote.message)
+		results[i] = accumulator.Add(buffer, nil, vote.publicKey, vote.signature)
+		// The pending votes must not see the buffer change
+		copy(buffer, "garbage!")
+	}
+	accumulator.Flush()
+	requireVoteResults(t, votes, results)
+}
@@ -0,0 +1,320 @@
+// Package chain verifies a light client's epoch chain: SNARK proofs over proven epoch ranges and the BLS
+// aggregated seals of the remaining epoch blocks, in overlapping stages on a pool of workers.
+package chain
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+
+	"github.com/celo-org/celo-bls-go-windows/bls"
+	"github.com/celo-org/celo-bls-go-windows/snark"
+)
+
+var ClosedError = errors.New("Verifier was closed")
+
+// An epoch block whose aggregated seal is verified with BLS
+type Epoch struct {
+	// Index of the epoch
+	Index uint16
+	// Round from consensus
+	Round uint8
+	// Epoch entropy value
+	BlockHash bls.EpochEntropy
+	// Parent entropy value
+	ParentHash bls.EpochEntropy
+	// Max non signers per block
+	MaxNonSigners uint32
+	// Max validators per block
+	MaxValidators uint32
+	// Serialized public keys of the validators added in this epoch
+	AddedPublicKeys [][]byte
+	// Serialized aggregate public key of the validators which signed the epoch block
+	AggregatePublicKey []byte
+	// Serialized aggregated signature over the epoch block
+	Signature []byte
+}
+
+// A SNARK proof of the epoch transitions between `FirstEpoch` and `LastEpoch`
+type ProofRange = snark.EpochProof
+
+// The outcome of verifying an epoch block (`First == Last`) or a proven epoch range
+type Verdict struct {
+	First uint16
+	Last  uint16
+	// nil if the epoch or range verified
+	Err error
+}
+
+// The hasher the epoch blocks were signed with
+type Hasher int
+
+const (
+	// Composite hasher with the CIP22 encoding, used for the epoch SNARK data
+	HasherCIP22 Hasher = iota
+	// Composite hasher without CIP22
+	HasherComposite
+	// Direct hasher
+	HasherDirect
+)
+
+func (self Hasher) flags() (shouldUseCompositeHasher, shouldUseCIP22 bool) {
+	switch self {
+	case HasherComposite:
+		return true, false
+	case HasherDirect:
+		return false, false
+	default:
+		return true, true
+	}
+}
+
+type Config struct {
+	// Number of workers for each stage, GOMAXPROCS if zero
+	Workers int
+	// Number of pushed epochs and proofs which may wait to be processed, before Push blocks
+	QueueSize int
+	// Maximum number of epoch blocks whose seals are batch verified together
+	BatchSize int
+	// Hasher of the epoch block seals, HasherCIP22 if zero
+	Hasher Hasher
+}
+
+// An epoch block whose seal is ready to be verified
+type preparedEpoch struct {
+	index  uint16
+	header *bls.SignedBlockHeader
+}
+
+// Verifier pipelines the verification of pushed epochs and proofs:
+// 1. epoch blocks are deserialized and encoded into their signed data by a pool of workers
+// 1. the prepared seals are grouped into batches while the next epochs are being prepared
+// 1. each batch is verified with a single batch verification, bisected to locate invalid seals
+//
+// Proofs are verified by their own pool of workers concurrently to the epochs. Verdicts are emitted as soon
+// as they are known, so they are not ordered by epoch.
+type Verifier struct {
+	verifyingKey snark.VerifyingKey
+	config       Config
+
+	proofs   chan ProofRange
+	epochs   chan Epoch
+	prepared chan preparedEpoch
+	batches  chan []preparedEpoch
+	verdicts chan Verdict
+
+	closeMutex sync.RWMutex
+	closed     bool
+}
+
+func NewVerifier(verifyingKey snark.VerifyingKey, config Config) *Verifier {
+	if config.Workers <= 0 {
+		config.Workers = runtime.GOMAXPROCS(0)
+	}
+	if config.QueueSize <= 0 {
+		config.QueueSize = 2 * config.Workers
+	}
+	if config.BatchSize <= 0 {
+		config.BatchSize = 64
+	}
+
+	self := &Verifier{
+		verifyingKey: verifyingKey,
+		config:       config,
+		proofs:       make(chan ProofRange, config.QueueSize),
+		epochs:       make(chan Epoch, config.QueueSize),
+		prepared:     make(chan preparedEpoch, config.QueueSize),
+		batches:      make(chan []preparedEpoch, config.Workers),
+		verdicts:     make(chan Verdict, config.QueueSize),
+	}
+
+	var prepareWorkers, verdictWorkers sync.WaitGroup
+	for i := 0; i < config.Workers; i++ {
+		prepareWorkers.Add(1)
+		go func() {
+			defer prepareWorkers.Done()
+			self.prepareEpochs()
+		}()
+
+		verdictWorkers.Add(2)
+		go func() {
+			defer verdictWorkers.Done()
+			self.verifyBatches()
+		}()
+		go func() {
+			defer verdictWorkers.Done()
+			self.verifyProofs()
+		}()
+	}
+
+	go func() {
+		prepareWorkers.Wait()
+		close(self.prepared)
+	}()
+	go self.batchEpochs()
+	go func() {
+		verdictWorkers.Wait()
+		close(self.verdicts)
+	}()
+
+	return self
+}
+
+// Verdicts returns the channel on which the verdicts are emitted. It is closed after `Close` once everything
+// pushed before has been verified. The pipeline stalls if the verdicts are not consumed.
+func (self *Verifier) Verdicts() <-chan Verdict {
+	return self.verdicts
+}
+
+// PushEpoch queues an epoch block for seal verification, blocking while the queue is full
+func (self *Verifier) PushEpoch(epoch Epoch) error {
+	self.closeMutex.RLock()
+	defer self.closeMutex.RUnlock()
+	if self.closed {
+		return ClosedError
+	}
+
+	self.epochs <- epoch
+	return nil
+}
+
+// PushProof queues an epoch range proof for verification, blocking while the queue is full
+func (self *Verifier) PushProof(proof ProofRange) error {
+	self.closeMutex.RLock()
+	defer self.closeMutex.RUnlock()
+	if self.closed {
+		return ClosedError
+	}
+
+	self.proofs <- proof
+	return nil
+}
+
+// Close stops accepting epochs and proofs. Those already pushed are still verified.
+func (self *Verifier) Close() {
+	self.closeMutex.Lock()
+	defer self.closeMutex.Unlock()
+	if self.closed {
+		return
+	}
+
+	self.closed = true
+	close(self.epochs)
+	close(self.proofs)
+}
+
+func (self *Verifier) verifyProofs() {
+	for proof := range self.proofs {
+		err := snark.VerifyEpochs(self.verifyingKey, proof.Proof, proof.FirstEpoch, proof.LastEpoch)
+		self.verdicts <- Verdict{First: proof.FirstEpoch.Index, Last: proof.LastEpoch.Index, Err: err}
+	}
+}
+
+func (self *Verifier) prepareEpochs() {
+	for epoch := range self.epochs {
+		header, err := prepareEpoch(&epoch, self.config.Hasher)
+		if err != nil {
+			self.verdicts <- Verdict{First: epoch.Index, Last: epoch.Index, Err: err}
+			continue
+		}
+		self.prepared <- preparedEpoch{index: epoch.Index, header: header}
+	}
+}
+
+// prepareEpoch deserializes the seal of an epoch block and encodes the data it signs. Epochs signed without CIP22
+// are encoded without their round, entropy and maximum number of validators.
+func prepareEpoch(epoch *Epoch, hasher Hasher) (*bls.SignedBlockHeader, error) {
+	addedPublicKeys := make([]*bls.PublicKey, 0, len(epoch.AddedPublicKeys))
+	defer func() {
+		for _, pk := range addedPublicKeys {
+			pk.Destroy()
+		}
+	}()
+	for _, publicKeyBytes := range epoch.AddedPublicKeys {
+		pk, err := bls.DeserializePublicKey(publicKeyBytes)
+		if err != nil {
+			return nil, err
+		}
+		addedPublicKeys = append(addedPublicKeys, pk)
+	}
+
+	var data, extra []byte
+	var err error
+	if hasher == HasherCIP22 {
+		data, extra, err = bls.EncodeEpochToBytesCIP22(epoch.Index, epoch.Round, epoch.BlockHash, epoch.ParentHash, epoch.MaxNonSigners, epoch.MaxValidators, addedPublicKeys)
+	} else {
+		data, err = bls.EncodeEpochToBytes(epoch.Index, epoch.MaxNonSigners, addedPublicKeys)
+	}
+	if err != nil {
+		return nil, err
+	}
+
+	pubkey, err := bls.DeserializePublicKey(epoch.AggregatePublicKey)
+	if err != nil {
+		return nil, err
+	}
+	sig, err := bls.DeserializeSignature(epoch.Signature)
+	if err != nil {
+		pubkey.Destroy()
+		return nil, err
+	}
+
+	return &bls.SignedBlockHeader{Data: data, Extra: extra, Pubkey: pubkey, Sig: sig}, nil
+}
+
+// batchEpochs groups the prepared epochs into batches, handing over a partial batch whenever no prepared
+// epoch is waiting so that verification never idles behind preparation
+func (self *Verifier) batchEpochs() {
+	defer close(self.batches)
+
+	batch := make([]preparedEpoch, 0, self.config.BatchSize)
+	flush := func() {
+		if len(batch) > 0 {
+			self.batches <- batch
+			batch = make([]preparedEpoch, 0, self.config.BatchSize)
+		}
+	}
+
+	for {
+		select {
+		case epoch, ok := <-self.prepared:
+			if !ok {
+				flush()
+				return
+			}
+			batch = append(batch, epoch)
+			if len(batch) == self.config.BatchSize {
+				flush()
+			}
+		default:
+			flush()
+			epoch, ok := <-self.prepared
+			if !ok {
+				return
+			}
+			batch = append(batch, epoch)
+		}
+	}
+}
+
+func (self *Verifier) verifyBatches() {
+	for batch := range self.batches {
+		headers := make([]*bls.SignedBlockHeader, len(batch))
+		for i, epoch := range batch {
+			headers[i] = epoch.header
+		}
+
+		shouldUseCompositeHasher, shouldUseCIP22 := self.config.Hasher.flags()
+		results, err := bls.BatchVerifyEpochsDetailed(headers, shouldUseCompositeHasher, shouldUseCIP22)
+		for i, epoch := range batch {
+			verdict := Verdict{First: epoch.index, Last: epoch.index}
+			if err != nil && (err != bls.NotVerifiedError || !results[i]) {
+				verdict.Err = err
+			}
+			self.verdicts <- verdict
+
+			epoch.header.Pubkey.Destroy()
+			epoch.header.Sig.Destroy()
+		}
+	}
+}
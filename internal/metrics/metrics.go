@@ -0,0 +1,44 @@
+// Package metrics keeps the cumulative number and duration of the native calls made by the bls and snark packages.
+package metrics
+
+import (
+	"sync/atomic"
+	"time"
+)
+
+// A Timer counts calls and their cumulative duration. It is safe for concurrent use.
+//
+// NB: its fields are accessed with 64-bit atomics, so a Timer must be 64-bit aligned on 32-bit platforms,
+// which holds for global variables.
+type Timer struct {
+	calls       uint64
+	nanoseconds uint64
+}
+
+// A point in time copy of a Timer
+type Snapshot struct {
+	// Number of calls
+	Calls uint64
+	// Cumulative duration of the calls, in nanoseconds
+	Nanoseconds uint64
+}
+
+// Record adds a call which started at start. It is meant to be deferred right before the call:
+//
+//	defer timer.Record(time.Now())
+func (self *Timer) Record(start time.Time) {
+	atomic.AddUint64(&self.calls, 1)
+	atomic.AddUint64(&self.nanoseconds, uint64(time.Since(start)))
+}
+
+func (self *Timer) Snapshot() Snapshot {
+	return Snapshot{
+		Calls:       atomic.LoadUint64(&self.calls),
+		Nanoseconds: atomic.LoadUint64(&self.nanoseconds),
+	}
+}
+
+func (self *Timer) Reset() {
+	atomic.StoreUint64(&self.calls, 0)
+	atomic.StoreUint64(&self.nanoseconds, 0)
+}
@@ -0,0 +1,28 @@
+package snark
+
+import (
+	"github.com/celo-org/celo-bls-go-windows/internal/metrics"
+)
+
+/// The number and cumulative duration of the native calls of an operation
+type OperationMetrics = metrics.Snapshot
+
+/// Metrics of the native calls made by this package. Durations of proofs verified in parallel add up.
+type Metrics struct {
+	/// Epoch range proof verifications
+	VerifyEpochs OperationMetrics
+}
+
+var verifyEpochsMetrics metrics.Timer
+
+/// GetMetrics returns the metrics accumulated since the process started or ResetMetrics was last called.
+func GetMetrics() Metrics {
+	return Metrics{
+		VerifyEpochs: verifyEpochsMetrics.Snapshot(),
+	}
+}
+
+/// ResetMetrics sets all metrics back to zero.
+func ResetMetrics() {
+	verifyEpochsMetrics.Reset()
+}
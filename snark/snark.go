@@ -7,10 +7,19 @@ import "C"
 
 import (
 	"errors"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
 	"unsafe"
 )
 
-var VerificationError = errors.New("SNARK proof verification failed")
+var (
+	VerificationError  = errors.New("SNARK proof verification failed")
+	IncorrectSizeError = errors.New("Public key had incorrect size")
+	AllocationError    = errors.New("Memory allocation failed")
+	EmptySliceError    = errors.New("Slice was empty")
+)
 
 /// Serialized Groth16 Proof
 type Proof []byte
@@ -34,6 +43,15 @@ type EpochBlock struct {
 	ParentEntropy []byte
 	/// Serialized public keys of the validators in this epoch (each `PUBLIC_KEY_BYTES` long)
 	PublicKeys [][]byte
+	/// Public keys of the validators packed once with `PackPublicKeys`. If set, it is used instead of `PublicKeys`
+	PackedPublicKeys *PackedPublicKeys
+}
+
+/// PackedPublicKeys holds the serialized public keys of a validator set back to back in natively allocated memory,
+/// so that the same set can be passed to many proof verifications without being repacked
+type PackedPublicKeys struct {
+	ptr *C.uchar
+	num int
 }
 
 const PUBLIC_KEY_BYTES = 96
@@ -46,12 +64,64 @@ func sliceToPtr(slice []byte) (*C.uchar, C.int) {
 	}
 }
 
-func vecToPtr(slice [][]byte) (*C.uchar, C.int) {
-	if len(slice) == 0 {
-		return nil, 0
-	} else {
-		return (*C.uchar)(unsafe.Pointer(&slice[0][0])), C.int(len(slice) * PUBLIC_KEY_BYTES)
+/// PackPublicKeys copies the serialized public keys into a single buffer, which must be released with `Destroy`
+func PackPublicKeys(publicKeys [][]byte) (*PackedPublicKeys, error) {
+	packed := &PackedPublicKeys{num: len(publicKeys)}
+	if len(publicKeys) == 0 {
+		return packed, nil
+	}
+
+	size := len(publicKeys) * PUBLIC_KEY_BYTES
+	packed.ptr = (*C.uchar)(C.malloc(C.size_t(size)))
+	if packed.ptr == nil {
+		return nil, AllocationError
+	}
+	buffer := (*[1 << 30]byte)(unsafe.Pointer(packed.ptr))[:size:size]
+	if err := packInto(buffer, publicKeys); err != nil {
+		packed.Destroy()
+		return nil, err
+	}
+
+	return packed, nil
+}
+
+/// Len returns the number of packed public keys
+func (self *PackedPublicKeys) Len() int {
+	return self.num
+}
+
+func (self *PackedPublicKeys) Destroy() {
+	C.free(unsafe.Pointer(self.ptr))
+	self.ptr = nil
+	self.num = 0
+}
+
+func packInto(buffer []byte, publicKeys [][]byte) error {
+	for i, publicKey := range publicKeys {
+		if len(publicKey) != PUBLIC_KEY_BYTES {
+			return IncorrectSizeError
+		}
+		copy(buffer[i*PUBLIC_KEY_BYTES:], publicKey)
+	}
+	return nil
+}
+
+/// publicKeysToPtr returns the epoch's public keys as one contiguous buffer and their count,
+/// packing `PublicKeys` into a new buffer unless `PackedPublicKeys` is set
+func publicKeysToPtr(epoch *EpochBlock) (*C.uchar, int, error) {
+	if epoch.PackedPublicKeys != nil {
+		return epoch.PackedPublicKeys.ptr, epoch.PackedPublicKeys.num, nil
+	}
+	if len(epoch.PublicKeys) == 0 {
+		return nil, 0, nil
+	}
+
+	buffer := make([]byte, len(epoch.PublicKeys)*PUBLIC_KEY_BYTES)
+	if err := packInto(buffer, epoch.PublicKeys); err != nil {
+		return nil, 0, err
 	}
+	publicKeysPtr, _ := sliceToPtr(buffer)
+	return publicKeysPtr, len(epoch.PublicKeys), nil
 }
 
 func VerifyEpochs(
@@ -63,7 +133,10 @@ func VerifyEpochs(
 	vkPtr, vkLen := sliceToPtr(verifyingKey)
 	proofPtr, proofLen := sliceToPtr(proof)
 
-	firstPublicKeysPtr, _ := vecToPtr(firstEpoch.PublicKeys)
+	firstPublicKeysPtr, firstPublicKeysNum, err := publicKeysToPtr(&firstEpoch)
+	if err != nil {
+		return err
+	}
 	firstEpochEntropyPtr, _ := sliceToPtr(firstEpoch.EpochEntropy)
 	firstParentEntropyPtr, _ := sliceToPtr(firstEpoch.ParentEntropy)
 	firstEpochRaw := C.EpochBlockFFI{
@@ -72,11 +145,14 @@ func VerifyEpochs(
 		maximum_validators:  C.ulong(firstEpoch.MaxValidators),
 		epoch_entropy:		 firstEpochEntropyPtr,
 		parent_entropy:		 firstParentEntropyPtr,
-		pubkeys_num:         C.ulong(len(firstEpoch.PublicKeys)),
+		pubkeys_num:         C.ulong(firstPublicKeysNum),
 		pubkeys:             firstPublicKeysPtr,
 	}
 
-	lastPublicKeysPtr, _ := vecToPtr(lastEpoch.PublicKeys)
+	lastPublicKeysPtr, lastPublicKeysNum, err := publicKeysToPtr(&lastEpoch)
+	if err != nil {
+		return err
+	}
 	lastEpochEntropyPtr, _ := sliceToPtr(lastEpoch.EpochEntropy)
 	lastParentEntropyPtr, _ := sliceToPtr(lastEpoch.ParentEntropy)
 	lastEpochRaw := C.EpochBlockFFI{
@@ -85,10 +161,11 @@ func VerifyEpochs(
 		maximum_validators:  C.ulong(lastEpoch.MaxValidators),
 		epoch_entropy:		 lastEpochEntropyPtr,
 		parent_entropy:		 lastParentEntropyPtr,
-		pubkeys_num:         C.ulong(len(lastEpoch.PublicKeys)),
+		pubkeys_num:         C.ulong(lastPublicKeysNum),
 		pubkeys:             lastPublicKeysPtr,
 	}
 
+	defer verifyEpochsMetrics.Record(time.Now())
 	success := C.verify(
 		vkPtr,
 		C.uint(vkLen),
@@ -104,3 +181,50 @@ func VerifyEpochs(
 
 	return nil
 }
+
+/// A proof of the epoch transitions between `FirstEpoch` and `LastEpoch`
+type EpochProof struct {
+	Proof      Proof
+	FirstEpoch EpochBlock
+	LastEpoch  EpochBlock
+}
+
+/// VerifyEpochsBatch verifies many epoch range proofs against the same verifying key, spreading them across
+/// GOMAXPROCS threads. It returns a nil error if all proofs verified, otherwise the bool slice contains the
+/// individual result of each proof. An empty list of proofs returns `EmptySliceError`.
+func VerifyEpochsBatch(verifyingKey VerifyingKey, proofs []EpochProof) ([]bool, error) {
+	if len(proofs) == 0 {
+		return nil, EmptySliceError
+	}
+
+	results := make([]bool, len(proofs))
+	workers := runtime.GOMAXPROCS(0)
+	if workers > len(proofs) {
+		workers = len(proofs)
+	}
+
+	var next int32 = -1
+	var wg sync.WaitGroup
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				i := int(atomic.AddInt32(&next, 1))
+				if i >= len(proofs) {
+					return
+				}
+				results[i] = VerifyEpochs(verifyingKey, proofs[i].Proof, proofs[i].FirstEpoch, proofs[i].LastEpoch) == nil
+			}
+		}()
+	}
+	wg.Wait()
+
+	for _, result := range results {
+		if !result {
+			return results, VerificationError
+		}
+	}
+
+	return nil, nil
+}
@@ -0,0 +1,86 @@
+// +build windows
+
+package snark
+
+import (
+	"encoding/json"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+/// benchFixturesEnv names the directory holding a proven epoch range: the verifying key in `vk.bin`, the proof in
+/// `proof.bin` and the first and last epochs in `epochs.json`, as `{"FirstEpoch": EpochBlock, "LastEpoch": EpochBlock}`.
+/// A valid proof can only be produced by the prover, so the benchmarks are skipped when it is not set.
+const benchFixturesEnv = "SNARK_BENCH_FIXTURES"
+
+type benchFixtures struct {
+	verifyingKey VerifyingKey
+	proof        Proof
+	FirstEpoch   EpochBlock
+	LastEpoch    EpochBlock
+}
+
+func loadBenchFixtures(b *testing.B) *benchFixtures {
+	dir := os.Getenv(benchFixturesEnv)
+	if dir == "" {
+		b.Skipf("%s is not set", benchFixturesEnv)
+	}
+
+	fixtures := &benchFixtures{}
+	verifyingKey, err := ioutil.ReadFile(filepath.Join(dir, "vk.bin"))
+	if err != nil {
+		b.Fatal(err)
+	}
+	proof, err := ioutil.ReadFile(filepath.Join(dir, "proof.bin"))
+	if err != nil {
+		b.Fatal(err)
+	}
+	epochs, err := ioutil.ReadFile(filepath.Join(dir, "epochs.json"))
+	if err != nil {
+		b.Fatal(err)
+	}
+	if err := json.Unmarshal(epochs, fixtures); err != nil {
+		b.Fatal(err)
+	}
+	fixtures.verifyingKey = verifyingKey
+	fixtures.proof = proof
+
+	if err := VerifyEpochs(fixtures.verifyingKey, fixtures.proof, fixtures.FirstEpoch, fixtures.LastEpoch); err != nil {
+		b.Fatalf("the fixtures do not verify: %v", err)
+	}
+	return fixtures
+}
+
+func BenchmarkVerifyEpochs(b *testing.B) {
+	fixtures := loadBenchFixtures(b)
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := VerifyEpochs(fixtures.verifyingKey, fixtures.proof, fixtures.FirstEpoch, fixtures.LastEpoch); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+/// BenchmarkVerifyEpochsPacked verifies with validator sets packed once, as a light client verifying many proofs does
+func BenchmarkVerifyEpochsPacked(b *testing.B) {
+	fixtures := loadBenchFixtures(b)
+
+	for _, epoch := range []*EpochBlock{&fixtures.FirstEpoch, &fixtures.LastEpoch} {
+		packed, err := PackPublicKeys(epoch.PublicKeys)
+		if err != nil {
+			b.Fatal(err)
+		}
+		defer packed.Destroy()
+		epoch.PackedPublicKeys = packed
+	}
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := VerifyEpochs(fixtures.verifyingKey, fixtures.proof, fixtures.FirstEpoch, fixtures.LastEpoch); err != nil {
+			b.Fatal(err)
+		}
+	}
+}